@@ -0,0 +1,27 @@
+int g;
+
+int foo(int x)
+{
+  if(x) return 9;
+  return 10;
+}
+
+int bar()
+{
+  g=10;
+  return 20;
+}
+
+int baz(int x)
+{
+  return foo(x)+bar();
+}
+
+void main()
+{
+  int x;
+  g=1;
+  x=baz(x);
+  assert(29<=x && x<=30);
+  assert(g==10);
+}
@@ -0,0 +1,30 @@
+int foo(int x)
+{
+  if(x) return 9;
+  return 10;
+}
+
+int bar(int x)
+{
+  if(x) return 20;
+  return 21;
+}
+
+int baz(int x)
+{
+  return foo(x)+1;
+}
+
+int qux(int x)
+{
+  return bar(x)+1;
+}
+
+void main()
+{
+  int x;
+  int y=baz(x);
+  int z=qux(x);
+  assert(10<=y && y<=11);
+  assert(21<=z && z<=22);
+}
@@ -0,0 +1,15 @@
+void main()
+{
+  int x = 0;
+  int y = 0;
+  int z = 1;
+
+  while(x<10)
+  {
+    x++;
+    z = z*3 + y;
+    y = z - x;
+  }
+
+  assert(x==10);
+}
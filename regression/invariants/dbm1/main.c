@@ -0,0 +1,13 @@
+void main()
+{
+  int x=0;
+  int y=0;
+
+  while(x<10)
+  {
+    x++;
+    y++;
+  }
+
+  assert(y==10);
+}
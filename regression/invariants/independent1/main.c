@@ -0,0 +1,22 @@
+int nondet_int();
+
+void main()
+{
+  int i=0;
+  int j=0;
+
+  while(nondet_int())
+  {
+    if(i<10)
+      i++;
+  }
+
+  while(nondet_int())
+  {
+    if(j<20)
+      j++;
+  }
+
+  assert(i<=10);
+  assert(j<=20);
+}
@@ -0,0 +1,13 @@
+void main()
+{
+  int i=0;
+  int j=0;
+
+  while(i>=0)
+    i=1;
+
+  while(j<20)
+    j++;
+
+  assert(i<0);
+}
@@ -0,0 +1,22 @@
+void main()
+{
+  int i=0;
+  int x=0;
+  int a=0;
+  int b=0;
+
+  while(i<100)
+  {
+    i++;
+    if(i<=100)
+      x++;
+    a+=2;
+    if(a>50)
+      a=0;
+    b+=3;
+    if(b>60)
+      b=0;
+  }
+
+  assert(x==i);
+}
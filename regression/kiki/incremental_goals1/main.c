@@ -0,0 +1,11 @@
+void main()
+{
+  int x=0;
+  int y=0;
+  while(x<10)
+  {
+    assert(y<5);
+    x++;
+    y++;
+  }
+}
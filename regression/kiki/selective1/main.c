@@ -0,0 +1,12 @@
+void main()
+{
+  int i, j, s=0;
+
+  for(i=0; i<2; i++)
+    s++;
+
+  for(j=0; j<5; j++)
+    s++;
+
+  assert(s!=7);
+}
@@ -0,0 +1,13 @@
+int foo(int n)
+{
+  int i=0;
+  while(i<n)
+    i++;
+  return i;
+}
+
+void main()
+{
+  int x=foo(10);
+  assert(x>=0);
+}
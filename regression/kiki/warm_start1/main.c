@@ -0,0 +1,15 @@
+void main()
+{
+  int x=0;
+  int y=0;
+
+  while(x<10)
+  {
+    x++;
+    if(y<5)
+      y++;
+    assert(x!=3);
+  }
+
+  assert(y<=5);
+}
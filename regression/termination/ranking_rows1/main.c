@@ -0,0 +1,23 @@
+void main()
+{
+  int x, y, n;
+  __CPROVER_assume(n>0 && n<1000);
+
+  for(x=0; x<n; x++);
+
+  // needs a lexicographic ranking function
+  x=n;
+  y=n;
+  while(x>0)
+  {
+    if(y>0)
+      y--;
+    else
+    {
+      x--;
+      y=n;
+    }
+  }
+
+  for(y=n; y>0; y--);
+}
@@ -43,6 +43,7 @@ Author: Daniel Kroening, Peter Schrammel
 #include "version.h"
 
 #include <ssa/malloc_ssa.h>
+#include <domains/solver_profiler.h>
 
 #include "graphml_witness_ext.h"
 #include <solver/summary_db.h>
@@ -81,7 +82,10 @@ twols_parse_optionst::twols_parse_optionst(int argc, const char **argv):
   ui_message_handler(cmdline, "2LS " TWOLS_VERSION),
   recursion_detected(false),
   threads_detected(false),
-  dynamic_memory_detected(false)
+  dynamic_memory_detected(false),
+  portfolio_worker(false),
+  arguments(argv, argv+argc),
+  server_library(NULL)
 {
 }
 
@@ -234,10 +238,26 @@ void twols_parse_optionst::get_command_line_options(optionst &options)
     else // if(cmdline.isset("intervals")) // default
       options.set_option("intervals", true);
 
+    // relational rows only for variables that interact
+    if(cmdline.isset("sparse-templates"))
+      options.set_option(
+        "sparse-templates", cmdline.get_value("sparse-templates"));
+
+    // separate domains for loops that do not depend on each other
+    if(cmdline.isset("independent-loops"))
+      options.set_option("independent-loops", true);
+
     if(cmdline.isset("enum-solver"))
       options.set_option("enum-solver", true);
     else // if(cmdline.isset("binsearch-solver")) // default
       options.set_option("binsearch-solver", true);
+
+    if(cmdline.isset("binsearch-multi-row"))
+      options.set_option("binsearch-multi-row", true);
+    if(cmdline.isset("binsearch-gallop"))
+      options.set_option("binsearch-gallop", true);
+    if(cmdline.isset("dbm-preanalysis"))
+      options.set_option("dbm-preanalysis", true);
   }
 
   // use incremental assertion checks
@@ -297,6 +317,14 @@ void twols_parse_optionst::get_command_line_options(optionst &options)
       options.set_option("unwind", std::numeric_limits<unsigned>::max());
   }
 
+  // unwind only the loops that may continue
+  if(cmdline.isset("selective-unwinding"))
+    options.set_option("selective-unwinding", true);
+
+  // start the invariant inference from the previous unwinding
+  if(cmdline.isset("warm-start"))
+    options.set_option("warm-start", true);
+
   // compute singleton recurrence set - simple nontermination
   if(cmdline.isset("nontermination"))
   {
@@ -335,6 +363,27 @@ void twols_parse_optionst::get_command_line_options(optionst &options)
   else
     options.set_option("all-functions", false);
 
+  // number of processes for summarizing independent functions
+  if(cmdline.isset("summary-jobs"))
+    options.set_option("summary-jobs", cmdline.get_value("summary-jobs"));
+
+  // directory for reusing summaries across runs
+  if(cmdline.isset("summary-cache"))
+    options.set_option("summary-cache", cmdline.get_value("summary-cache"));
+
+  // per-function and per-phase profile of the solver calls
+  if(cmdline.isset("profile-json"))
+    options.set_option("profile-json", cmdline.get_value("profile-json"));
+
+  // only give the relevant parts of the SSA to the solver
+  if(cmdline.isset("cone-of-influence"))
+    options.set_option("cone-of-influence", true);
+
+  // rebuild the solvers when popped contexts hold this many clauses
+  if(cmdline.isset("solver-compaction"))
+    options.set_option(
+      "solver-compaction", cmdline.get_value("solver-compaction"));
+
   // competition mode
   if(cmdline.isset("competition-mode"))
   {
@@ -393,6 +442,18 @@ int twols_parse_optionst::doit()
     return 0;
   }
 
+  if(cmdline.isset("server"))
+  {
+    eval_verbosity();
+    return server();
+  }
+
+  if(cmdline.isset("portfolio") && !portfolio_worker)
+  {
+    eval_verbosity();
+    return portfolio();
+  }
+
   //
   // command line options
   //
@@ -579,6 +640,9 @@ int twols_parse_optionst::doit()
     return 5;
   }
 
+  if(options.get_option("profile-json")!="")
+    solver_profilert::enable();
+
   try
   {
     std::unique_ptr<summary_checker_baset> checker;
@@ -714,6 +778,8 @@ int twols_parse_optionst::doit()
       checker->instrument_and_output(goto_model);
     }
 
+    output_profile(options);
+
     return retval;
   }
 
@@ -1096,7 +1162,11 @@ bool twols_parse_optionst::get_goto_program(
 
     // finally add the library
     status() << "Adding CPROVER library" << eom;
+    if(server_library!=NULL)
+      link_server_library(goto_model);
     link_to_library(goto_model, ui_message_handler);
+    if(!server_library_file.empty())
+      save_server_library(goto_model);
 
     if(process_goto_program(options, goto_model))
       return true;
@@ -1624,6 +1694,38 @@ void twols_parse_optionst::output_json_cex(
 
 /*******************************************************************\
 
+Function: twols_parse_optionst::output_profile
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void twols_parse_optionst::output_profile(const optionst &options)
+{
+  const std::string file=options.get_option("profile-json");
+  if(file=="")
+    return;
+
+  if(file=="-")
+    solver_profilert::output_json(std::cout);
+  else
+  {
+    std::ofstream out(file.c_str());
+    if(!out)
+    {
+      error() << "Failed to open output file " << file << eom;
+      return;
+    }
+    solver_profilert::output_json(out);
+  }
+}
+
+/*******************************************************************\
+
 Function: twols_parse_optionst::report_failure
 
   Inputs:
@@ -1762,12 +1864,30 @@ void twols_parse_optionst::help()
     "\n"
     "Backend options:\n"
     " --all-functions              check each function as entry point\n"
+    " --summary-jobs n             summarize independent functions in n processes\n" // NOLINT(*)
+    " --summary-cache dir          reuse summaries stored in dir across runs\n" // NOLINT(*)
+    " --profile-json file          write a profile of the solver calls to file\n" // NOLINT(*)
+    " --solver-compaction n        rebuild a solver when n clauses are dead\n" // NOLINT(*)
+    " --cone-of-influence          only give the parts of the SSA to the solver\n" // NOLINT(*)
+    "                              that influence properties and templates\n"
+    " --portfolio                  run k-induction, incremental BMC and\n"
+    "                              abstract interpretation with intervals,\n"
+    "                              zones and heap-interval in parallel and\n"
+    "                              report the first conclusive result\n"
+    " --server                     read jobs as JSON objects from stdin, one\n" // NOLINT(*)
+    "                              per line, and write the results as JSON\n" // NOLINT(*)
+    " --server-socket path         read jobs from a local Unix socket instead\n" // NOLINT(*)
     " --stop-on-fail               stop on first failing assertion\n"
     " --trace                      give a counterexample trace for failed properties\n" //NOLINT(*)
     " --context-sensitive          context-sensitive analysis from entry point\n" // NOLINT(*)
     " --termination                compute ranking functions to prove termination\n" // NOLINT(*)
     " --k-induction                use k-induction\n"
     " --incremental-bmc            use incremental-bmc\n"
+    " --selective-unwinding        with k-induction and incremental-bmc, only\n"
+    "                              unwind loops that may continue further\n"
+    " --warm-start                 with k-induction and incremental-bmc, start\n" // NOLINT(*)
+    "                              the invariant inference from the invariant\n" // NOLINT(*)
+    "                              of the previous unwinding\n"
     " --preconditions              compute preconditions\n"
     " --sufficient                 sufficient preconditions (default: necessary)\n" // NOLINT(*)
     " --havoc                      havoc loops and function calls\n"
@@ -1776,6 +1896,11 @@ void twols_parse_optionst::help()
     " --heap                       use heap domain\n"
     " --zones                      use zone domain\n"
     " --octagons                   use octagon domain\n"
+    " --sparse-templates n         with zones and octagons, only relate loop\n" // NOLINT(*)
+    "                              variables that interact within n steps\n" // NOLINT(*)
+    "                              in the loop body\n"
+    " --independent-loops          analyze loops whose invariants do not\n"
+    "                              depend on each other separately\n"
     " --heap-interval              use heap domain with interval domain for\n"
     "                              values\n"
     " --heap-zones                 use heap domain with zones domain for values\n" // NOLINT(*)
@@ -1785,6 +1910,12 @@ void twols_parse_optionst::help()
     "                              (only usable with --heap-* switches)\n"
     " --enum-solver                use solver based on model enumeration\n"
     " --binsearch-solver           use solver based on binary search\n"
+    " --binsearch-multi-row        improve all improvable template rows\n"
+    "                              after each improvement check\n"
+    " --binsearch-gallop           search row values upwards from the model\n"
+    "                              value and program constants before bisecting\n" // NOLINT(*)
+    " --dbm-preanalysis            bound the binary search by the result\n"
+    "                              of a zone analysis of the goto program\n"
     " --arrays                     do not ignore array contents\n"
     " --lexicographic-ranking-function n          (default n=3)\n"
     " --monolithic-ranking-function\n"
@@ -9,17 +9,21 @@ Author: Daniel Kroening, Peter Schrammel
 #ifndef CPROVER_2LS_2LS_2LS_PARSE_OPTIONS_H
 #define CPROVER_2LS_2LS_2LS_PARSE_OPTIONS_H
 
+#include <map>
+#include <vector>
+
 #include <util/ui_message.h>
 #include <util/parse_options.h>
 #include <util/replace_symbol.h>
 
 #include <langapi/language_ui.h>
 
+#include <goto-programs/goto_model.h>
 #include <analyses/goto_check.h>
 #include <ssa/dynobj_instance_analysis.h>
 
-class goto_modelt;
 class optionst;
+class jsont;
 
 #include "summary_checker_base.h"
 
@@ -49,6 +53,8 @@ class optionst;
   "(heap-values-refine)" \
   "(sympath)" \
   "(enum-solver)(binsearch-solver)(arrays)"\
+  "(binsearch-multi-row)(binsearch-gallop)(dbm-preanalysis)" \
+  "(sparse-templates):(independent-loops)" \
   "(string-abstraction)(no-arch)(arch):(floatbv)(fixedbv)" \
   "(round-to-nearest)(round-to-plus-inf)(round-to-minus-inf)(round-to-zero)" \
   "(inline)(inline-main)(inline-partial):" \
@@ -60,7 +66,9 @@ class optionst;
   "(show-goto-functions)(show-guards)(show-defs)(show-ssa)(show-assignments)" \
   "(show-invariants)(std-invariants)(show-imprecise-vars)" \
   "(property):(all-properties)(k-induction)(incremental-bmc)" \
-  "(no-spurious-check)(all-functions)" \
+  "(no-spurious-check)(all-functions)(summary-jobs):(summary-cache):" \
+  "(profile-json):(solver-compaction):(portfolio)(cone-of-influence)" \
+  "(selective-unwinding)(warm-start)(server)(server-socket):" \
   "(no-simplify)(no-fixed-point)" \
   "(graphml-witness):(json-cex):" \
   "(no-spurious-check)(stop-on-fail)" \
@@ -87,10 +95,27 @@ protected:
   bool recursion_detected;
   bool threads_detected;
   bool dynamic_memory_detected;
+  bool portfolio_worker;
+  // the command line, for the configurations of the portfolio
+  std::vector<std::string> arguments;
   virtual void register_languages();
 
   void get_command_line_options(optionst &options);
 
+  int portfolio();
+
+  int server();
+  void serve(int in_fd, int out_fd);
+  int run_job(const jsont &job, std::string &output);
+
+  // library functions linked by earlier jobs of the server,
+  // by the options of the jobs
+  std::map<std::string, goto_modelt> server_libraries;
+  const goto_modelt *server_library;
+  std::string server_library_file;
+  void link_server_library(goto_modelt &goto_model);
+  void save_server_library(const goto_modelt &goto_model);
+
   bool get_goto_program(
     const optionst &options,
     goto_modelt &goto_model);
@@ -129,6 +154,8 @@ protected:
     const goto_tracet &error_trace,
     const std::string &property_id);
 
+  void output_profile(const optionst &options);
+
   struct expr_statst
   {
     bool has_malloc;
@@ -121,6 +121,7 @@ void cover_goals_extt::operator()()
   _iterations=_number_covered=0;
 
   decision_proceduret::resultt dec_result;
+  solver_profilert::phaset profiler_phase("cover-goals");
 
   // We use incremental solving, so need to freeze some variables
   // to prevent them from being eliminated.
@@ -210,6 +211,7 @@ void cover_goals_extt::assignment()
     return;
   }
 
+  solver_profilert::phaset profiler_phase("spurious-check");
   solver.new_context();
   // force avoiding paths going through invariants
 
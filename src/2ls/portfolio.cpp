@@ -0,0 +1,200 @@
+/*******************************************************************\
+
+Module: Portfolio of Verification Techniques
+
+Author: Peter Schrammel
+
+\*******************************************************************/
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <vector>
+#include <set>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+#endif
+
+#include <util/tempfile.h>
+
+#include "2ls_parse_options.h"
+
+/*******************************************************************\
+
+Function: twols_parse_optionst::portfolio
+
+  Inputs:
+
+ Outputs: exit code of the first configuration that has been
+          conclusive, or of the first configuration otherwise
+
+ Purpose: runs the analysis with several configurations in forked
+          processes; each configuration replaces the engine and
+          domain options of the command line; the output of a
+          configuration goes to a temporary file and is only shown
+          for the configuration whose result is reported; the other
+          processes are killed as soon as one is conclusive
+
+\*******************************************************************/
+
+int twols_parse_optionst::portfolio()
+{
+#ifdef _WIN32
+  error() << "--portfolio is not supported on this platform" << eom;
+  return 6;
+#else
+  // the command line options that are added for each configuration
+  std::vector<std::vector<std::string> > configurations;
+  configurations.push_back({"k-induction"});
+  configurations.push_back({"incremental-bmc"});
+  configurations.push_back({"intervals"});
+  configurations.push_back({"zones"});
+  configurations.push_back({"heap-interval"});
+
+  // the options that select the engine or the domain
+  const std::set<std::string> engine_and_domain_options=
+  {
+    "--k-induction", "--incremental-bmc", "--havoc",
+    "--intervals", "--zones", "--qzones", "--octagons", "--equalities",
+    "--heap", "--heap-interval", "--heap-zones", "--heap-values-refine"
+  };
+
+  std::size_t n=configurations.size();
+  std::vector<pid_t> pids(n, -1);
+  std::vector<std::string> files(n);
+  std::vector<int> exit_codes(n, -1);
+
+  status() << "Running portfolio of " << n << " configurations" << eom;
+  std::cout.flush();
+  std::cerr.flush();
+
+  for(std::size_t i=0; i<n; ++i)
+  {
+    files[i]=get_temporary_file("2ls_portfolio_", ".log");
+    pids[i]=fork();
+    if(pids[i]!=0)
+    {
+      // each configuration runs in a process group of its own,
+      //  so that its worker processes can be terminated with it
+      if(pids[i]>0)
+        setpgid(pids[i], pids[i]);
+      continue;
+    }
+
+    // worker process
+    setpgid(0, 0);
+    int fd=open(files[i].c_str(), O_WRONLY|O_TRUNC);
+    if(fd<0)
+      _exit(6);
+    dup2(fd, 1);
+    dup2(fd, 2);
+    close(fd);
+
+    std::vector<std::string> args;
+    for(const auto &arg : arguments)
+    {
+      if(engine_and_domain_options.find(arg)==
+         engine_and_domain_options.end())
+        args.push_back(arg);
+    }
+    for(const auto &option : configurations[i])
+      args.push_back("--"+option);
+
+    std::vector<const char *> argv;
+    for(const auto &arg : args)
+      argv.push_back(arg.c_str());
+
+    cmdline.clear();
+    if(cmdline.parse(argv.size(), argv.data(), TWOLS_OPTIONS))
+      _exit(6);
+    portfolio_worker=true;
+
+    int exit_code=doit();
+    std::cout.flush();
+    std::cerr.flush();
+    _exit(exit_code);
+  }
+
+  // wait for the first conclusive result
+  std::size_t winner=n;
+  std::size_t running=0;
+  for(std::size_t i=0; i<n; ++i)
+  {
+    if(pids[i]>0)
+      running++;
+    else
+      warning() << "Failed to start configuration "
+                << configurations[i].front() << eom;
+  }
+
+  // only our configurations are waited for, other children of
+  //  this process are not ours to reap
+  while(running>0 && winner==n)
+  {
+    bool finished=false;
+    for(std::size_t i=0; i<n && winner==n; ++i)
+    {
+      if(pids[i]<=0)
+        continue;
+      int status_code;
+      pid_t pid=waitpid(pids[i], &status_code, WNOHANG);
+      if(pid==0)
+        continue;
+
+      finished=true;
+      running--;
+      pids[i]=-1;
+      if(pid>0 && WIFEXITED(status_code))
+        exit_codes[i]=WEXITSTATUS(status_code);
+
+      // 0: verification successful, 10: verification failed
+      if(exit_codes[i]==0 || exit_codes[i]==10)
+        winner=i;
+    }
+    if(!finished)
+      usleep(10000);
+  }
+
+  // cancel the remaining configurations with their worker processes
+  for(std::size_t i=0; i<n; ++i)
+  {
+    if(pids[i]>0)
+    {
+      kill(-pids[i], SIGTERM);
+      waitpid(pids[i], NULL, 0);
+    }
+  }
+
+  std::size_t reported=winner;
+  if(winner!=n)
+  {
+    status() << "Configuration " << configurations[winner].front()
+             << " has been conclusive" << eom;
+  }
+  else
+  {
+    status() << "No configuration has been conclusive" << eom;
+    for(reported=0; reported<n; ++reported)
+      if(exit_codes[reported]>=0)
+        break;
+  }
+
+  int exit_code=6;
+  if(reported<n)
+  {
+    std::ifstream in(files[reported].c_str());
+    std::cout << in.rdbuf();
+    std::cout.flush();
+    exit_code=exit_codes[reported];
+  }
+
+  for(const auto &file : files)
+    std::remove(file.c_str());
+
+  return exit_code;
+#endif
+}
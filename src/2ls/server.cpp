@@ -0,0 +1,532 @@
+/*******************************************************************\
+
+Module: Server Mode for Batches of Verification Tasks
+
+Author: Peter Schrammel
+
+\*******************************************************************/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <csignal>
+#include <set>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#endif
+
+#include <util/tempfile.h>
+#include <util/json.h>
+#include <util/prefix.h>
+#include <util/find_symbols.h>
+#include <json/json_parser.h>
+#include <goto-programs/compute_called_functions.h>
+#include <goto-programs/read_goto_binary.h>
+#include <goto-programs/write_goto_binary.h>
+
+#include "2ls_parse_options.h"
+
+/*******************************************************************\
+
+Function: is_library_location
+
+  Inputs: source location
+
+ Outputs: true if the location is in the CPROVER library
+
+ Purpose:
+
+\*******************************************************************/
+
+static bool is_library_location(const source_locationt &location)
+{
+  return has_prefix(id2string(location.get_file()), "<builtin-library");
+}
+
+/*******************************************************************\
+
+Function: add_library_symbols
+
+  Inputs: library symbols, symbols to add, symbol table
+
+ Outputs:
+
+ Purpose: adds the given library symbols and the symbols that they
+          refer to unless the symbol table has them already
+
+\*******************************************************************/
+
+static void add_library_symbols(
+  const symbol_tablet &library,
+  find_symbols_sett symbols,
+  symbol_tablet &dest)
+{
+  while(!symbols.empty())
+  {
+    irep_idt id=*symbols.begin();
+    symbols.erase(symbols.begin());
+    if(dest.symbols.find(id)!=dest.symbols.end())
+      continue;
+    symbol_tablet::symbolst::const_iterator s_it=library.symbols.find(id);
+    if(s_it==library.symbols.end())
+      continue;
+    dest.add(s_it->second);
+    find_type_and_expr_symbols(s_it->second.type, symbols);
+    find_type_and_expr_symbols(s_it->second.value, symbols);
+  }
+}
+
+/*******************************************************************\
+
+Function: twols_parse_optionst::link_server_library
+
+  Inputs: goto model
+
+ Outputs:
+
+ Purpose: copies the library functions that earlier jobs of the
+          server have linked such that link_to_library parses
+          only the remaining ones
+
+\*******************************************************************/
+
+void twols_parse_optionst::link_server_library(goto_modelt &goto_model)
+{
+  const symbol_tablet &library_symbols=server_library->symbol_table;
+  const goto_functionst::function_mapt &library_functions=
+    server_library->goto_functions.function_map;
+  goto_functionst::function_mapt &function_map=
+    goto_model.goto_functions.function_map;
+
+  unsigned linked=0;
+  bool changed=true;
+  while(changed)
+  {
+    changed=false;
+    std::set<irep_idt> called=
+      compute_called_functions(goto_model.goto_functions);
+    for(const auto &id : called)
+    {
+      goto_functionst::function_mapt::const_iterator f_it=
+        function_map.find(id);
+      if(f_it!=function_map.end() && f_it->second.body_available())
+        continue;
+      goto_functionst::function_mapt::const_iterator l_it=
+        library_functions.find(id);
+      symbol_tablet::symbolst::const_iterator l_s_it=
+        library_symbols.symbols.find(id);
+      if(l_it==library_functions.end() ||
+         l_s_it==library_symbols.symbols.end())
+        continue;
+
+      // leave declarations that differ from the library to the linker
+      symbol_tablet::symbolst::iterator s_it=
+        goto_model.symbol_table.symbols.find(id);
+      if(s_it!=goto_model.symbol_table.symbols.end())
+      {
+        if(s_it->second.type!=l_s_it->second.type ||
+           (s_it->second.value.is_not_nil() &&
+            s_it->second.value!=l_s_it->second.value))
+          continue;
+        s_it->second=l_s_it->second;
+      }
+      else
+        goto_model.symbol_table.add(l_s_it->second);
+
+      find_symbols_sett symbols;
+      find_type_and_expr_symbols(l_s_it->second.type, symbols);
+      find_type_and_expr_symbols(l_s_it->second.value, symbols);
+      add_library_symbols(library_symbols, symbols, goto_model.symbol_table);
+
+      function_map[id].copy_from(l_it->second);
+      linked++;
+      changed=true;
+    }
+  }
+
+  if(linked>0)
+  {
+    goto_model.goto_functions.update();
+    status() << "Reusing " << linked
+             << " library function(s) of earlier jobs" << eom;
+  }
+}
+
+/*******************************************************************\
+
+Function: twols_parse_optionst::save_server_library
+
+  Inputs: goto model after linking the library
+
+ Outputs:
+
+ Purpose: writes the linked library functions for the server such
+          that later jobs can reuse them
+
+\*******************************************************************/
+
+void twols_parse_optionst::save_server_library(const goto_modelt &goto_model)
+{
+  symbol_tablet symbol_table;
+  goto_functionst goto_functions;
+
+  forall_symbols(it, goto_model.symbol_table.symbols)
+    if(is_library_location(it->second.location))
+      symbol_table.add(it->second);
+
+  forall_goto_functions(it, goto_model.goto_functions)
+  {
+    if(!it->second.body_available() ||
+       !is_library_location(
+         it->second.body.instructions.front().source_location))
+      continue;
+    symbol_tablet::symbolst::const_iterator s_it=
+      goto_model.symbol_table.symbols.find(it->first);
+    if(s_it==goto_model.symbol_table.symbols.end())
+      continue;
+    symbol_table.add(s_it->second);
+    goto_functions.function_map[it->first].copy_from(it->second);
+  }
+
+  write_goto_binary(
+    server_library_file,
+    symbol_table,
+    goto_functions,
+    get_message_handler());
+}
+
+#ifndef _WIN32
+
+/*******************************************************************\
+
+Function: merge_server_library
+
+  Inputs: library functions written by a job, library of the server
+
+ Outputs:
+
+ Purpose: adds the library functions of the job that the server
+          does not have yet
+
+\*******************************************************************/
+
+static void merge_server_library(
+  const std::string &file,
+  goto_modelt &library)
+{
+  goto_modelt job_library;
+  null_message_handlert null_message_handler;
+  if(read_goto_binary(file, job_library, null_message_handler))
+    return;
+
+  forall_symbols(it, job_library.symbol_table.symbols)
+    if(library.symbol_table.symbols.find(it->first)==
+       library.symbol_table.symbols.end())
+      library.symbol_table.add(it->second);
+
+  goto_functionst::function_mapt &function_map=
+    library.goto_functions.function_map;
+  forall_goto_functions(it, job_library.goto_functions)
+    if(function_map.find(it->first)==function_map.end())
+      function_map[it->first].copy_from(it->second);
+}
+
+/*******************************************************************\
+
+Function: read_line
+
+  Inputs: file descriptor, buffer with the data read so far
+
+ Outputs: false if the input has ended
+
+ Purpose:
+
+\*******************************************************************/
+
+static bool read_line(int fd, std::string &buffer, std::string &line)
+{
+  std::size_t pos;
+  while((pos=buffer.find('\n'))==std::string::npos)
+  {
+    char data[4096];
+    ssize_t n=read(fd, data, sizeof(data));
+    if(n<=0)
+    {
+      if(buffer.empty())
+        return false;
+      line.swap(buffer);
+      buffer.clear();
+      return true;
+    }
+    buffer.append(data, n);
+  }
+  line=buffer.substr(0, pos);
+  buffer.erase(0, pos+1);
+  return true;
+}
+
+/*******************************************************************\
+
+Function: write_all
+
+  Inputs: file descriptor, data
+
+ Outputs: false if the reader has gone away
+
+ Purpose:
+
+\*******************************************************************/
+
+static bool write_all(int fd, const std::string &data)
+{
+  std::size_t written=0;
+  while(written<data.size())
+  {
+    ssize_t n=write(fd, data.c_str()+written, data.size()-written);
+    if(n<=0)
+      return false;
+    written+=n;
+  }
+  return true;
+}
+
+/*******************************************************************\
+
+Function: twols_parse_optionst::run_job
+
+  Inputs: job description
+
+ Outputs: exit code of the analysis, its output
+
+ Purpose: runs the analysis in a forked process such that every job
+          starts from the state of the server process; the output
+          of the job goes to a temporary file; the library functions
+          that the job links are kept for later jobs with the same
+          options
+
+\*******************************************************************/
+
+int twols_parse_optionst::run_job(const jsont &job, std::string &output)
+{
+  std::vector<std::string> args;
+  args.push_back("2ls");
+  std::string options_key;
+  for(const auto &option : job["options"].array)
+  {
+    args.push_back(option.value);
+    options_key+=option.value+'\n';
+  }
+  if(job["function"].is_string())
+  {
+    args.push_back("--function");
+    args.push_back(job["function"].value);
+  }
+  args.push_back(job["file"].value);
+
+  std::string file=get_temporary_file("2ls_server_", ".log");
+  std::string library_file=get_temporary_file("2ls_server_", ".gb");
+  goto_modelt &library=server_libraries[options_key];
+  std::cout.flush();
+  std::cerr.flush();
+
+  pid_t pid=fork();
+  if(pid==0)
+  {
+    // worker process
+    signal(SIGPIPE, SIG_DFL);
+    int fd=open(file.c_str(), O_WRONLY|O_TRUNC);
+    if(fd<0)
+      _exit(6);
+    dup2(fd, 1);
+    dup2(fd, 2);
+    close(fd);
+
+    std::vector<const char *> argv;
+    for(const auto &arg : args)
+      argv.push_back(arg.c_str());
+
+    server_library=&library;
+    server_library_file=library_file;
+    arguments=args;
+
+    cmdline.clear();
+    if(cmdline.parse(argv.size(), argv.data(), TWOLS_OPTIONS) ||
+       cmdline.isset("server"))
+    {
+      std::cerr << "invalid options for job" << std::endl;
+      _exit(1);
+    }
+
+    int exit_code=doit();
+    std::cout.flush();
+    std::cerr.flush();
+    _exit(exit_code);
+  }
+
+  int exit_code=6;
+  if(pid>0)
+  {
+    int status_code;
+    if(waitpid(pid, &status_code, 0)==pid && WIFEXITED(status_code))
+      exit_code=WEXITSTATUS(status_code);
+  }
+  if(exit_code!=6)
+    merge_server_library(library_file, library);
+  std::remove(library_file.c_str());
+
+  std::ifstream in(file.c_str());
+  std::ostringstream out;
+  out << in.rdbuf();
+  output=out.str();
+  std::remove(file.c_str());
+
+  return exit_code;
+}
+
+/*******************************************************************\
+
+Function: twols_parse_optionst::serve
+
+  Inputs: file descriptors to read jobs from and to write results to
+
+ Outputs:
+
+ Purpose: reads one job per line, e.g.
+          {"id": "1", "file": "main.c", "function": "main",
+           "options": ["--k-induction"]},
+          and writes one result object per job
+
+\*******************************************************************/
+
+void twols_parse_optionst::serve(int in_fd, int out_fd)
+{
+  std::string buffer, line;
+  while(read_line(in_fd, buffer, line))
+  {
+    if(line.find_first_not_of(" \t\r")==std::string::npos)
+      continue;
+
+    json_objectt result;
+
+    jsont job;
+    std::istringstream in(line);
+    null_message_handlert null_message_handler;
+    if(parse_json(in, "", null_message_handler, job) ||
+       !job.is_object() ||
+       !job["file"].is_string())
+    {
+      result["result"]=json_stringt("ERROR");
+      result["output"]=json_stringt("invalid job: "+line);
+      std::ostringstream out;
+      out << result << '\n';
+      if(!write_all(out_fd, out.str()))
+        return;
+      continue;
+    }
+
+    if(job["id"].is_string() || job["id"].is_number())
+      result["id"]=job["id"];
+
+    std::string output;
+    int exit_code=run_job(job, output);
+
+    // 0: verification successful, 10: verification failed,
+    //  5: unknown
+    std::string verdict="ERROR";
+    if(exit_code==0)
+      verdict="SUCCESSFUL";
+    else if(exit_code==10)
+      verdict="FAILED";
+    else if(exit_code==5)
+      verdict="UNKNOWN";
+
+    result["exit-code"]=json_numbert(std::to_string(exit_code));
+    result["result"]=json_stringt(verdict);
+    result["output"]=json_stringt(output);
+    std::ostringstream out;
+    out << result << '\n';
+    if(!write_all(out_fd, out.str()))
+      return;
+  }
+}
+
+#endif
+
+/*******************************************************************\
+
+Function: twols_parse_optionst::server
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: analyzes jobs from stdin, or from the connections to a local
+          Unix socket, in one long-lived process
+
+\*******************************************************************/
+
+int twols_parse_optionst::server()
+{
+#ifdef _WIN32
+  error() << "--server is not supported on this platform" << eom;
+  return 6;
+#else
+  // a client that goes away must not terminate the server
+  signal(SIGPIPE, SIG_IGN);
+
+  if(!cmdline.isset("server-socket"))
+  {
+    serve(0, 1);
+    return 0;
+  }
+
+  std::string path=cmdline.get_value("server-socket");
+  struct sockaddr_un address;
+  if(path.size()>=sizeof(address.sun_path))
+  {
+    error() << "socket path too long: " << path << eom;
+    return 6;
+  }
+  memset(&address, 0, sizeof(address));
+  address.sun_family=AF_UNIX;
+  strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path)-1);
+
+  // remove the socket of a server that has not terminated cleanly
+  struct stat info;
+  if(stat(path.c_str(), &info)==0 && S_ISSOCK(info.st_mode))
+    unlink(path.c_str());
+
+  int server_fd=socket(AF_UNIX, SOCK_STREAM, 0);
+  if(server_fd<0 ||
+     bind(server_fd, (struct sockaddr *)&address, sizeof(address))!=0 ||
+     listen(server_fd, 16)!=0)
+  {
+    error() << "cannot listen on socket " << path << eom;
+    return 6;
+  }
+
+  status() << "Listening on " << path << eom;
+  while(true)
+  {
+    int connection_fd=accept(server_fd, NULL, NULL);
+    if(connection_fd<0)
+      break;
+    serve(connection_fd, connection_fd);
+    close(connection_fd);
+  }
+
+  close(server_fd);
+  unlink(path.c_str());
+  return 0;
+#endif
+}
@@ -23,12 +23,16 @@ Author: Peter Schrammel
 #include <ssa/simplify_ssa.h>
 #include <ssa/ssa_build_goto_trace.h>
 #include <domains/ssa_analyzer.h>
+#include <domains/util.h>
 #include <ssa/ssa_unwinder.h>
+#include <ssa/ssa_slicer.h>
 
 #include <solver/summarizer_fw.h>
 #include <solver/summarizer_fw_term.h>
 #include <solver/summarizer_bw.h>
 #include <solver/summarizer_bw_term.h>
+#include <solver/summary_cache.h>
+#include <solver/summary_scheduler.h>
 
 #ifdef SHOW_CALLING_CONTEXTS
 #include <solver/summarizer_fw_contexts.h>
@@ -56,7 +60,10 @@ void summary_checker_baset::SSA_functions(
   const namespacet &ns,
   const ssa_heap_analysist &heap_analysis)
 {
+  absolute_timet ssa_start=current_time();
+
   // compute SSA for all the functions
+  std::set<irep_idt> functions;
   forall_goto_functions(f_it, goto_model.goto_functions)
   {
     if(!f_it->second.body_available())
@@ -75,9 +82,19 @@ void summary_checker_baset::SSA_functions(
       ::simplify(SSA, ns);
     }
 
-    SSA.output(debug()); debug() << eom;
+    functions.insert(f_it->first);
+
+    if(message_enabled(*this, M_DEBUG))
+    {
+      SSA.output(debug());
+      debug() << eom;
+    }
   }
 
+  ssa_db.share_expressions(functions);
+
+  ssa_time+=current_time()-ssa_start;
+
   // properties
   initialize_property_map(goto_model.goto_functions);
 }
@@ -125,17 +142,42 @@ void summary_checker_baset::summarize(
 
   summarizer->set_message_handler(get_message_handler());
 
+  // summaries computed in a calling context cannot be reused
+  summary_cachet *summary_cache=NULL;
+  if(options.get_option("summary-cache")!="" &&
+     !options.get_bool_option("context-sensitive"))
+  {
+    summary_cache=new summary_cachet(
+      options, ssa_db, summary_db, options.get_option("summary-cache"));
+    summary_cache->set_message_handler(get_message_handler());
+    summary_cache->load(forward, termination);
+  }
+
   if(!options.get_bool_option("context-sensitive") &&
      options.get_bool_option("all-functions"))
     summarizer->summarize();
   else
     summarizer->summarize(goto_model.goto_functions.entry_point());
 
+  if(summary_cache!=NULL)
+  {
+    summary_cache->store();
+    summary_cache_hits+=summary_cache->get_number_of_hits();
+    summary_cache_misses+=summary_cache->get_number_of_misses();
+    delete summary_cache;
+  }
+
   // statistics
   solver_instances+=summarizer->get_number_of_solver_instances();
   solver_calls+=summarizer->get_number_of_solver_calls();
+  solver_rebuilds+=summarizer->get_number_of_solver_rebuilds();
+  context_conversions+=summarizer->get_number_of_context_conversions();
+  reused_literals+=summarizer->get_number_of_reused_literals();
   summaries_used+=summarizer->get_number_of_summaries_used();
   termargs_computed+=summarizer->get_number_of_termargs_computed();
+  bound_search_calls+=summarizer->get_number_of_bound_search_calls();
+  bound_search_calls_baseline+=
+    summarizer->get_number_of_bound_search_calls_baseline();
 
   delete summarizer;
 }
@@ -204,10 +246,15 @@ void summary_checker_baset::check_properties(
   const ssa_dbt::functionst::const_iterator f_it)
 {
   unwindable_local_SSAt &SSA=*f_it->second;
+  solver_profilert::functiont profiler_function(f_it->first);
 
   bool all_properties=options.get_bool_option("all-properties");
 
-  SSA.output_verbose(debug()); debug() << eom;
+  if(message_enabled(*this, M_DEBUG))
+  {
+    SSA.output_verbose(debug());
+    debug() << eom;
+  }
 
   // incremental version
 
@@ -216,8 +263,35 @@ void summary_checker_baset::check_properties(
   solver.set_message_handler(get_message_handler());
 
   // give SSA to solver
-  solver << SSA;
-  SSA.mark_nodes();
+  if(options.get_bool_option("cone-of-influence"))
+  {
+    // only the parts of the SSA that influence the properties
+    exprt::operandst seeds;
+    seeds.push_back(SSA.get_enabling_exprs());
+    for(const auto &node : SSA.nodes)
+      for(const auto &a : node.assertions)
+        seeds.push_back(a);
+    if(summary_db.exists(f_it->first))
+    {
+      const summaryt &summary=summary_db.get(f_it->first);
+      seeds.push_back(summary.fw_invariant);
+      seeds.push_back(summary.fw_precondition);
+      seeds.push_back(summary.aux_precondition);
+    }
+    seeds.push_back(ssa_inliner.get_summaries(SSA));
+    exprt::operandst loop_continues=
+      get_loop_continues(f_it->first, SSA, *solver.solver);
+    seeds.insert(seeds.end(), loop_continues.begin(), loop_continues.end());
+
+    ssa_slicert ssa_slicer;
+    ssa_slicer.set_message_handler(get_message_handler());
+    ssa_slicer(solver, SSA, seeds);
+  }
+  else
+  {
+    solver << SSA;
+    SSA.mark_nodes();
+  }
 
   solver.new_context();
 
@@ -327,7 +401,8 @@ void summary_checker_baset::check_properties(
   {
     // Our goal is to falsify a property.
     // The following is TRUE if the conjunction is empty.
-    literalt p=!solver.convert(conjunction(it->second.conjuncts));
+    literalt p=!get_property_literal(
+      f_it->first, it->first, it->second.conjuncts, solver);
     cover_goals.add(p);
   }
 
@@ -351,6 +426,19 @@ void summary_checker_baset::check_properties(
     }
   }
 
+  // select the loops to be unwound further for the undecided properties
+  if(!fully_unwound && options.get_bool_option("selective-unwinding"))
+  {
+    for(const auto &goal : cover_goals.goal_map)
+    {
+      if(property_map[goal.first].result==UNKNOWN)
+      {
+        find_continuing_loops(f_it->first, loophead_selects, solver);
+        break;
+      }
+    }
+  }
+
   solver.pop_context();
 
   debug() << "** " << cover_goals.number_covered()
@@ -360,6 +448,75 @@ void summary_checker_baset::check_properties(
 
 /*******************************************************************\
 
+Function: summary_checker_baset::get_property_literal
+
+  Inputs: function, property, its assertion instances in the current
+          unwinding, solver of the function
+
+ Outputs: literal of the conjunction of the instances
+
+ Purpose: the instances from previous unwindings are still in the
+          SSA, hence only the instances that have been added by the
+          latest unwinding are converted; the conjunction is built
+          from scratch if an instance has disappeared or the solver
+          has been rebuilt since; the literals are those of the SAT
+          instance, hence, this is invalid with NON_INCREMENTAL,
+          which creates a new SAT instance for every solver call
+
+\*******************************************************************/
+
+literalt summary_checker_baset::get_property_literal(
+  const irep_idt &function_name,
+  const irep_idt &property_id,
+  const exprt::operandst &instances,
+  incremental_solvert &solver)
+{
+  property_literalt &property_literal=
+    property_literals[function_name][property_id];
+
+  bool reuse=
+    property_literal.rebuilds==solver.get_number_of_rebuilds();
+  if(reuse && !property_literal.instances.empty())
+  {
+    std::unordered_set<exprt, irep_hash> current(
+      instances.begin(), instances.end());
+    for(const auto &instance : property_literal.instances)
+    {
+      if(current.find(instance)==current.end())
+      {
+        reuse=false;
+        break;
+      }
+    }
+  }
+  if(!reuse)
+    property_literal=property_literalt();
+
+  unsigned converted=0;
+  for(const auto &instance : instances)
+  {
+    if(!property_literal.instances.insert(instance).second)
+      continue;
+    property_literal.conjunction=
+      solver.sat_check->land(
+        property_literal.conjunction, solver.convert(instance));
+    converted++;
+  }
+  // the literal is used again after further unwindings,
+  //  the intermediate conjunctions are not
+  if(converted>0)
+    solver.sat_check->set_frozen(property_literal.conjunction);
+  property_literal.rebuilds=solver.get_number_of_rebuilds();
+
+  debug() << "Property " << property_id << ": " << converted << " of "
+          << property_literal.instances.size()
+          << " assertion instances converted" << eom;
+
+  return property_literal.conjunction;
+}
+
+/*******************************************************************\
+
 Function: summary_checker_baset::report_statistics
 
   Inputs:
@@ -372,6 +529,9 @@ Function: summary_checker_baset::report_statistics
 
 void summary_checker_baset::report_statistics()
 {
+  unsigned rebuilds=solver_rebuilds;
+  unsigned conversions=context_conversions;
+  unsigned reused=reused_literals;
   for(ssa_dbt::functionst::const_iterator f_it=ssa_db.functions().begin();
       f_it!=ssa_db.functions().end(); f_it++)
   {
@@ -380,14 +540,33 @@ void summary_checker_baset::report_statistics()
     if(calls>0)
       solver_instances++;
     solver_calls+=calls;
+    rebuilds+=solver.get_number_of_rebuilds();
+    conversions+=solver.get_number_of_context_conversions();
+    reused+=solver.get_number_of_reused_literals();
   }
   statistics() << "** statistics: " << eom;
+  statistics() << "  SSA construction time: " << ssa_time << "s" << eom;
   statistics() << "  number of solver instances: " << solver_instances << eom;
   statistics() << "  number of solver calls: " << solver_calls << eom;
   statistics() << "  number of summaries used: "
                << summaries_used << eom;
   statistics() << "  number of termination arguments computed: "
                << termargs_computed << eom;
+  statistics() << "  number of solver calls for row value search: "
+               << bound_search_calls << " (plain binary search: "
+               << bound_search_calls_baseline << ")" << eom;
+  statistics() << "  number of reused literals: " << reused
+               << " of " << conversions << " context constraints" << eom;
+  if(options.get_unsigned_int_option("solver-compaction")>0)
+    statistics() << "  number of solver compactions: "
+                 << rebuilds << eom;
+  if(options.get_option("summary-cache")!="")
+  {
+    statistics() << "  number of summary cache hits: "
+                 << summary_cache_hits << eom;
+    statistics() << "  number of summary cache misses: "
+                 << summary_cache_misses << eom;
+  }
   statistics() << eom;
 }
 
@@ -531,6 +710,7 @@ bool summary_checker_baset::is_fully_unwound(
   const exprt::operandst &loophead_selects,
   incremental_solvert &solver)
 {
+  solver_profilert::phaset profiler_phase("unwinding-check");
   solver.new_context();
   solver <<
     and_exprt(conjunction(loophead_selects), disjunction(loop_continues));
@@ -558,6 +738,156 @@ bool summary_checker_baset::is_fully_unwound(
 
 /*******************************************************************\
 
+Function: summary_checker_baset::find_continuing_loops
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: collects the loops whose continuation condition is
+          satisfiable, i.e. those that need to be unwound further
+
+\*******************************************************************/
+
+void summary_checker_baset::find_continuing_loops(
+  const irep_idt &function_name,
+  const exprt::operandst &loophead_selects,
+  incremental_solvert &solver)
+{
+  solver_profilert::phaset profiler_phase("unwinding-check");
+
+  exprt::operandst loop_continues;
+  std::vector<unsigned> loop_heads;
+  ssa_unwinder.get(function_name).loop_continuation_conditions(
+    loop_continues, loop_heads);
+
+  std::vector<literalt> literals;
+  literals.reserve(loop_continues.size());
+  for(const auto &loop_continue : loop_continues)
+    literals.push_back(solver.convert(loop_continue));
+
+  std::set<unsigned> &loops=continuing_loops[function_name];
+
+  solver.new_context();
+  solver << conjunction(loophead_selects);
+
+  // look for a further loop that may continue until there is none
+  while(true)
+  {
+    exprt::operandst remaining;
+    for(std::size_t i=0; i<literals.size(); ++i)
+    {
+      if(loops.find(loop_heads[i])==loops.end())
+        remaining.push_back(literal_exprt(literals[i]));
+    }
+    if(remaining.empty())
+      break;
+
+    solver.new_context();
+    solver << disjunction(remaining);
+
+    solver_calls++; // statistics
+
+    decision_proceduret::resultt result=solver();
+    if(result==decision_proceduret::D_SATISFIABLE)
+    {
+      for(std::size_t i=0; i<literals.size(); ++i)
+      {
+        if(solver.solver->l_get(literals[i]).is_true())
+          loops.insert(loop_heads[i]);
+      }
+    }
+    else if(result!=decision_proceduret::D_UNSATISFIABLE)
+      throw "error from decision procedure";
+
+    solver.pop_context();
+
+    if(result==decision_proceduret::D_UNSATISFIABLE)
+      break;
+  }
+
+  solver.pop_context();
+
+  if(loops.empty())
+    continuing_loops.erase(function_name);
+}
+
+/*******************************************************************\
+
+Function: summary_checker_baset::unwind_continuing_loops
+
+  Inputs:
+
+ Outputs: returns false if there are no loops to be unwound further
+
+ Purpose: unwinds the loops selected by find_continuing_loops
+          one more time
+
+\*******************************************************************/
+
+bool summary_checker_baset::unwind_continuing_loops()
+{
+  if(continuing_loops.empty())
+    return false;
+
+  for(const auto &f : continuing_loops)
+  {
+    status() << "Unwinding " << f.second.size() << " loop(s) of "
+             << f.first << " further" << eom;
+    ssa_unwinder.unwind_further(f.first, f.second);
+  }
+  continuing_loops.clear();
+  return true;
+}
+
+/*******************************************************************\
+
+Function: summary_checker_baset::mark_recompute_changed
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: marks the summaries of the functions whose SSA has been
+          unwound further, and of their transitive callers,
+          for recomputation; the summaries of all other functions
+          are still valid
+
+\*******************************************************************/
+
+void summary_checker_baset::mark_recompute_changed()
+{
+  const std::set<irep_idt> &changed=ssa_unwinder.get_changed_functions();
+  if(changed.empty())
+    return;
+
+  summary_schedulert scheduler(ssa_db);
+  scheduler();
+  std::map<irep_idt, std::set<irep_idt> > callers;
+  for(const auto &f : scheduler.get_call_graph())
+    for(const auto &callee : f.second)
+      callers[callee].insert(f.first);
+
+  std::set<irep_idt> affected;
+  std::vector<irep_idt> worklist(changed.begin(), changed.end());
+  while(!worklist.empty())
+  {
+    irep_idt f=worklist.back();
+    worklist.pop_back();
+    if(!affected.insert(f).second)
+      continue;
+    summary_db.mark_recompute(f);
+    for(const auto &caller : callers[f])
+      worklist.push_back(caller);
+  }
+
+  debug() << "Recomputing " << affected.size() << " of "
+          << ssa_db.functions().size() << " summaries" << eom;
+  ssa_unwinder.clear_changed_functions();
+}
+
+/*******************************************************************\
+
 Function: summary_checker_baset::is_spurious
 
   Inputs:
@@ -587,6 +917,7 @@ bool summary_checker_baset::is_spurious(
     return false;
 
   // force avoiding paths going through invariants
+  solver_profilert::phaset profiler_phase("spurious-check");
   solver << conjunction(loophead_selects);
 
   solver_calls++; // statistics
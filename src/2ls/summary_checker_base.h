@@ -9,6 +9,8 @@ Author: Peter Schrammel
 #ifndef CPROVER_2LS_2LS_SUMMARY_CHECKER_BASE_H
 #define CPROVER_2LS_2LS_SUMMARY_CHECKER_BASE_H
 
+#include <unordered_set>
+
 #include <util/time_stopping.h>
 #include <goto-programs/property_checker.h>
 #include <solvers/prop/prop_conv.h>
@@ -41,8 +43,15 @@ public:
     heap_analysis(_heap_analysis),
     solver_instances(0),
     solver_calls(0),
+    solver_rebuilds(0),
+    context_conversions(0),
+    reused_literals(0),
     summaries_used(0),
-    termargs_computed(0)
+    termargs_computed(0),
+    summary_cache_hits(0),
+    summary_cache_misses(0),
+    bound_search_calls(0),
+    bound_search_calls_baseline(0)
   {
     ssa_inliner.set_message_handler(get_message_handler());
   }
@@ -57,6 +66,7 @@ public:
   // statistics
   absolute_timet start_time;
   time_periodt sat_time;
+  time_periodt ssa_time;
 
 protected:
   optionst &options;
@@ -70,8 +80,15 @@ protected:
 
   unsigned solver_instances;
   unsigned solver_calls;
+  unsigned solver_rebuilds;
+  unsigned context_conversions;
+  unsigned reused_literals;
   unsigned summaries_used;
   unsigned termargs_computed;
+  unsigned summary_cache_hits;
+  unsigned summary_cache_misses;
+  unsigned bound_search_calls;
+  unsigned bound_search_calls_baseline;
   void report_statistics();
 
   void do_show_vcc(
@@ -109,6 +126,41 @@ protected:
     const exprt::operandst& loophead_selects,
     incremental_solvert&);
 
+  // loops that may iterate further in functions with undecided properties
+  typedef std::map<irep_idt, std::set<unsigned> > continuing_loopst;
+  continuing_loopst continuing_loops;
+  void find_continuing_loops(
+    const irep_idt &function_name,
+    const exprt::operandst& loophead_selects,
+    incremental_solvert&);
+  bool unwind_continuing_loops();
+
+  void mark_recompute_changed();
+
+  // the assertion instances of a property that have been converted
+  //  in the solver of the function, and the literal of their conjunction,
+  //  which are kept across unwindings
+  struct property_literalt
+  {
+    property_literalt():
+      conjunction(const_literal(true)),
+      rebuilds(0)
+    {
+    }
+
+    std::unordered_set<exprt, irep_hash> instances;
+    literalt conjunction;
+    unsigned rebuilds; // of the solver when the literal was built
+  };
+  typedef std::map<irep_idt, std::map<irep_idt, property_literalt> >
+    property_literalst;
+  property_literalst property_literals;
+  literalt get_property_literal(
+    const irep_idt &function_name,
+    const irep_idt &property_id,
+    const exprt::operandst &instances,
+    incremental_solvert &solver);
+
   friend graphml_witness_extt;
 };
 
@@ -41,10 +41,16 @@ property_checkert::resultt summary_checker_kindt::operator()(
   {
     status() << "Unwinding (k=" << unwind << ")" << eom;
 
-    // TODO: recompute only functions with loops
-    summary_db.mark_recompute_all();
-
-    ssa_unwinder.unwind_all(unwind);
+    // unwind only the loops that may continue for undecided properties
+    //  if there are any, otherwise all loops
+    if(unwind==0 ||
+       !options.get_bool_option("selective-unwinding") ||
+       !unwind_continuing_loops())
+      ssa_unwinder.unwind_all(unwind);
+    continuing_loops.clear();
+
+    // only the summaries that depend on the unwound loops are outdated
+    mark_recompute_changed();
 
     result=check_properties();
     bool magic_limit_not_reached=
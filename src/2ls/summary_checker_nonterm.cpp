@@ -108,6 +108,8 @@ void summary_checker_nontermt::check_properties(
 #endif
 
   // solver
+  solver_profilert::functiont profiler_function(f_it->first);
+  solver_profilert::phaset profiler_phase("nontermination");
   incremental_solvert &solver=ssa_db.get_solver(f_it->first);
   solver.set_message_handler(get_message_handler());
 
@@ -244,6 +246,8 @@ void summary_checker_nontermt::check_properties_linear(
   ssa_local_unwindert &ssa_local_unwinder=ssa_unwinder.get(f_it->first);
 
   // solver
+  solver_profilert::functiont profiler_function(f_it->first);
+  solver_profilert::phaset profiler_phase("nontermination");
   incremental_solvert &solver=ssa_db.get_solver(f_it->first);
   solver.set_message_handler(get_message_handler());
 
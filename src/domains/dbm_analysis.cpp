@@ -0,0 +1,970 @@
+/*******************************************************************\
+
+Module: Zone (difference-bound matrix) abstract interpretation
+        used as pre-analysis for template polyhedra
+
+Author: Peter Schrammel
+
+\*******************************************************************/
+
+#include <cctype>
+#include <string>
+
+#include <util/arith_tools.h>
+#include <util/std_code.h>
+#include <util/std_expr.h>
+
+#include "dbm_analysis.h"
+
+// number of loop iterations before widening
+#define DBM_WIDENING_DELAY 2
+
+/*******************************************************************\
+
+Function: get_type_range
+
+  Inputs:
+
+ Outputs: false if the type is not an integer bitvector type
+
+ Purpose:
+
+\*******************************************************************/
+
+bool get_type_range(const typet &type, mp_integer &lower, mp_integer &upper)
+{
+  if(type.id()==ID_signedbv)
+  {
+    lower=to_signedbv_type(type).smallest();
+    upper=to_signedbv_type(type).largest();
+    return true;
+  }
+  if(type.id()==ID_unsignedbv)
+  {
+    lower=to_unsignedbv_type(type).smallest();
+    upper=to_unsignedbv_type(type).largest();
+    return true;
+  }
+  return false;
+}
+
+/*******************************************************************\
+
+Function: dbm_domaint::init_matrix
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: turns top into a matrix with the ranges of the types
+
+\*******************************************************************/
+
+void dbm_domaint::init_matrix(const dbm_analysist &dbm)
+{
+  assert(!bottom);
+  if(!matrix.empty())
+    return;
+
+  std::size_t n=dbm.var_map.size()+1;
+  matrix.assign(n, std::vector<boundt>(n));
+  for(std::size_t i=0; i<n; ++i)
+    matrix[i][i]=boundt(0);
+  for(std::size_t i=1; i<n; ++i)
+  {
+    matrix[i][0]=boundt(dbm.var_upper[i]);
+    matrix[0][i]=boundt(-dbm.var_lower[i]);
+  }
+  close();
+}
+
+/*******************************************************************\
+
+Function: dbm_domaint::get_bound
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+dbm_domaint::boundt dbm_domaint::get_bound(unsigned i, unsigned j) const
+{
+  if(bottom)
+    return boundt(-1); // anything
+  if(matrix.empty())
+    return boundt();
+  return matrix[i][j];
+}
+
+/*******************************************************************\
+
+Function: dbm_domaint::close
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: shortest-path closure (Floyd-Warshall), detects emptiness
+
+\*******************************************************************/
+
+void dbm_domaint::close()
+{
+  std::size_t n=matrix.size();
+  for(std::size_t k=0; k<n; ++k)
+  {
+    for(std::size_t i=0; i<n; ++i)
+    {
+      if(matrix[i][k].inf)
+        continue;
+      for(std::size_t j=0; j<n; ++j)
+      {
+        if(matrix[k][j].inf)
+          continue;
+        mp_integer sum=matrix[i][k].value+matrix[k][j].value;
+        if(matrix[i][j].inf || sum<matrix[i][j].value)
+          matrix[i][j]=boundt(sum);
+      }
+    }
+  }
+
+  for(std::size_t i=0; i<n; ++i)
+  {
+    if(matrix[i][i].value<0)
+    {
+      bottom=true;
+      matrix.clear();
+      return;
+    }
+  }
+}
+
+/*******************************************************************\
+
+Function: dbm_domaint::havoc
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: forgets all constraints on var (matrix is closed)
+
+\*******************************************************************/
+
+void dbm_domaint::havoc(unsigned var, const dbm_analysist &dbm)
+{
+  init_matrix(dbm);
+  for(std::size_t j=0; j<matrix.size(); ++j)
+  {
+    matrix[var][j]=boundt();
+    matrix[j][var]=boundt();
+  }
+  matrix[var][var]=boundt(0);
+  matrix[var][0]=boundt(dbm.var_upper[var]);
+  matrix[0][var]=boundt(-dbm.var_lower[var]);
+  close();
+}
+
+/*******************************************************************\
+
+Function: dbm_domaint::add_constraint
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: x_i-x_j<=c
+
+\*******************************************************************/
+
+void dbm_domaint::add_constraint(unsigned i, unsigned j, const mp_integer &c)
+{
+  if(bottom)
+    return;
+  if(matrix[i][j].inf || c<matrix[i][j].value)
+  {
+    matrix[i][j]=boundt(c);
+    close();
+  }
+}
+
+/*******************************************************************\
+
+Function: dbm_domaint::get_interval
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: interval of a tracked variable
+
+\*******************************************************************/
+
+void dbm_domaint::get_interval(
+  unsigned var,
+  const dbm_analysist &dbm,
+  mp_integer &lower,
+  mp_integer &upper) const
+{
+  lower=dbm.var_lower[var];
+  upper=dbm.var_upper[var];
+  if(matrix.empty())
+    return;
+  if(!matrix[var][0].inf && matrix[var][0].value<upper)
+    upper=matrix[var][0].value;
+  if(!matrix[0][var].inf && -matrix[0][var].value>lower)
+    lower=-matrix[0][var].value;
+}
+
+/*******************************************************************\
+
+Function: dbm_domaint::get_interval
+
+  Inputs:
+
+ Outputs: false if the value of the expression is unknown
+          (or may overflow)
+
+ Purpose:
+
+\*******************************************************************/
+
+bool dbm_domaint::get_interval(
+  const exprt &expr,
+  const dbm_analysist &dbm,
+  mp_integer &lower,
+  mp_integer &upper) const
+{
+  mp_integer type_lower, type_upper;
+  if(!get_type_range(expr.type(), type_lower, type_upper))
+    return false;
+
+  if(expr.id()==ID_constant)
+  {
+    if(to_integer(expr, lower))
+      return false;
+    upper=lower;
+    return true;
+  }
+  else if(expr.id()==ID_symbol)
+  {
+    dbm_analysist::var_mapt::const_iterator it=
+      dbm.var_map.find(to_symbol_expr(expr).get_identifier());
+    if(it==dbm.var_map.end())
+      return false;
+    get_interval(it->second, dbm, lower, upper);
+    return true;
+  }
+  else if(expr.id()==ID_typecast)
+  {
+    if(!get_interval(to_typecast_expr(expr).op(), dbm, lower, upper))
+      return false;
+  }
+  else if(expr.id()==ID_unary_minus)
+  {
+    mp_integer l, u;
+    if(!get_interval(to_unary_minus_expr(expr).op(), dbm, l, u))
+      return false;
+    lower=-u;
+    upper=-l;
+  }
+  else if(expr.id()==ID_plus || expr.id()==ID_minus)
+  {
+    if(expr.operands().size()!=2)
+      return false;
+    mp_integer l0, u0, l1, u1;
+    if(!get_interval(expr.op0(), dbm, l0, u0) ||
+       !get_interval(expr.op1(), dbm, l1, u1))
+      return false;
+    if(expr.id()==ID_plus)
+    {
+      lower=l0+l1;
+      upper=u0+u1;
+    }
+    else
+    {
+      lower=l0-u1;
+      upper=u0-l1;
+    }
+  }
+  else if(expr.id()==ID_mult)
+  {
+    if(expr.operands().size()!=2)
+      return false;
+    mp_integer l0, u0, l1, u1;
+    if(!get_interval(expr.op0(), dbm, l0, u0) ||
+       !get_interval(expr.op1(), dbm, l1, u1))
+      return false;
+    mp_integer p[4]={ l0*l1, l0*u1, u0*l1, u0*u1 };
+    lower=upper=p[0];
+    for(unsigned i=1; i<4; ++i)
+    {
+      if(p[i]<lower)
+        lower=p[i];
+      if(p[i]>upper)
+        upper=p[i];
+    }
+  }
+  else
+    return false;
+
+  // bitvector semantics coincide with integer semantics
+  //  only without overflows
+  return lower>=type_lower && upper<=type_upper;
+}
+
+/*******************************************************************\
+
+Function: dbm_domaint::get_linear
+
+  Inputs:
+
+ Outputs: false if the expression is not of the form x+c or c,
+          or if it may overflow
+
+ Purpose: var is 0 for constants
+
+\*******************************************************************/
+
+bool dbm_domaint::get_linear(
+  const exprt &expr,
+  const dbm_analysist &dbm,
+  unsigned &var,
+  mp_integer &c) const
+{
+  mp_integer lower, upper;
+  if(!get_interval(expr, dbm, lower, upper))
+    return false;
+
+  if(expr.id()==ID_constant)
+  {
+    var=0;
+    c=lower;
+    return true;
+  }
+  if(expr.id()==ID_symbol)
+  {
+    var=dbm.var_map.find(to_symbol_expr(expr).get_identifier())->second;
+    c=0;
+    return true;
+  }
+  if(expr.id()==ID_typecast)
+    return get_linear(to_typecast_expr(expr).op(), dbm, var, c);
+  if((expr.id()==ID_plus || expr.id()==ID_minus) &&
+     expr.operands().size()==2)
+  {
+    unsigned var0, var1;
+    mp_integer c0, c1;
+    if(!get_linear(expr.op0(), dbm, var0, c0) ||
+       !get_linear(expr.op1(), dbm, var1, c1))
+      return false;
+    if(expr.id()==ID_plus && (var0==0 || var1==0))
+    {
+      var=var0+var1;
+      c=c0+c1;
+      return true;
+    }
+    if(expr.id()==ID_minus && var1==0)
+    {
+      var=var0;
+      c=c0-c1;
+      return true;
+    }
+  }
+  return false;
+}
+
+/*******************************************************************\
+
+Function: dbm_domaint::assign
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void dbm_domaint::assign(
+  unsigned var,
+  const exprt &rhs,
+  const dbm_analysist &dbm)
+{
+  init_matrix(dbm);
+
+  unsigned rhs_var;
+  mp_integer c;
+  if(get_linear(rhs, dbm, rhs_var, c))
+  {
+    if(rhs_var==var) // x:=x+c
+    {
+      for(std::size_t j=0; j<matrix.size(); ++j)
+      {
+        if(j==var)
+          continue;
+        if(!matrix[var][j].inf)
+          matrix[var][j].value+=c;
+        if(!matrix[j][var].inf)
+          matrix[j][var].value-=c;
+      }
+      return;
+    }
+
+    // x:=y+c
+    havoc(var, dbm);
+    add_constraint(var, rhs_var, c);
+    add_constraint(rhs_var, var, -c);
+    return;
+  }
+
+  mp_integer lower, upper;
+  bool known=get_interval(rhs, dbm, lower, upper);
+  havoc(var, dbm);
+  if(known)
+  {
+    add_constraint(var, 0, upper);
+    add_constraint(0, var, -lower);
+  }
+}
+
+/*******************************************************************\
+
+Function: dbm_domaint::assume
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void dbm_domaint::assume(const exprt &cond, const dbm_analysist &dbm)
+{
+  if(bottom)
+    return;
+
+  if(cond.is_false())
+  {
+    make_bottom();
+    matrix.clear();
+    return;
+  }
+
+  if(cond.id()==ID_and)
+  {
+    forall_operands(it, cond)
+      assume(*it, dbm);
+    return;
+  }
+
+  exprt c=cond;
+  bool negated=false;
+  while(c.id()==ID_not)
+  {
+    exprt tmp=to_not_expr(c).op();
+    c=tmp;
+    negated=!negated;
+  }
+
+  if(c.operands().size()!=2)
+    return;
+
+  irep_idt id=c.id();
+  if(negated)
+  {
+    if(id==ID_le)
+      id=ID_gt;
+    else if(id==ID_lt)
+      id=ID_ge;
+    else if(id==ID_ge)
+      id=ID_lt;
+    else if(id==ID_gt)
+      id=ID_le;
+    else if(id==ID_equal)
+      id=ID_notequal;
+    else
+      return;
+  }
+
+  if(id!=ID_le && id!=ID_lt && id!=ID_ge && id!=ID_gt && id!=ID_equal)
+    return;
+
+  unsigned var0, var1;
+  mp_integer c0, c1;
+  if(!get_linear(c.op0(), dbm, var0, c0) ||
+     !get_linear(c.op1(), dbm, var1, c1))
+    return;
+
+  init_matrix(dbm);
+
+  // x0+c0 <= x1+c1  <=>  x0-x1 <= c1-c0
+  if(id==ID_le || id==ID_equal)
+    add_constraint(var0, var1, c1-c0);
+  if(id==ID_lt)
+    add_constraint(var0, var1, c1-c0-1);
+  if(id==ID_ge || id==ID_equal)
+    add_constraint(var1, var0, c0-c1);
+  if(id==ID_gt)
+    add_constraint(var1, var0, c0-c1-1);
+}
+
+/*******************************************************************\
+
+Function: dbm_domaint::transform
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void dbm_domaint::transform(
+  locationt from,
+  locationt to,
+  ai_baset &ai,
+  const namespacet &ns)
+{
+  if(bottom)
+    return;
+
+  const dbm_analysist &dbm=static_cast<dbm_analysist &>(ai);
+  const goto_programt::instructiont &instruction=*from;
+
+  switch(instruction.type)
+  {
+  case DECL:
+  case DEAD:
+  {
+    const exprt &symbol=instruction.code.op0();
+    dbm_analysist::var_mapt::const_iterator it=
+      dbm.var_map.find(to_symbol_expr(symbol).get_identifier());
+    if(it!=dbm.var_map.end())
+      havoc(it->second, dbm);
+    break;
+  }
+
+  case ASSIGN:
+  {
+    const code_assignt &code_assign=to_code_assign(instruction.code);
+    if(code_assign.lhs().id()==ID_symbol)
+    {
+      dbm_analysist::var_mapt::const_iterator it=
+        dbm.var_map.find(to_symbol_expr(code_assign.lhs()).get_identifier());
+      if(it!=dbm.var_map.end())
+        assign(it->second, code_assign.rhs(), dbm);
+    }
+    break;
+  }
+
+  case FUNCTION_CALL:
+  {
+    const code_function_callt &code_function_call=
+      to_code_function_call(instruction.code);
+    if(code_function_call.lhs().id()==ID_symbol)
+    {
+      dbm_analysist::var_mapt::const_iterator it=dbm.var_map.find(
+        to_symbol_expr(code_function_call.lhs()).get_identifier());
+      if(it!=dbm.var_map.end())
+        havoc(it->second, dbm);
+    }
+    break;
+  }
+
+  case GOTO:
+  {
+    locationt next=from;
+    next++;
+    if(from->get_target()!=next) // else it's a skip
+    {
+      if(next==to)
+        assume(not_exprt(instruction.guard), dbm);
+      else
+        assume(instruction.guard, dbm);
+    }
+    break;
+  }
+
+  case ASSUME:
+    assume(instruction.guard, dbm);
+    break;
+
+  default:
+    break;
+  }
+}
+
+/*******************************************************************\
+
+Function: dbm_domaint::merge
+
+  Inputs:
+
+ Outputs: true if this has changed
+
+ Purpose: join, widening on back edges
+
+\*******************************************************************/
+
+bool dbm_domaint::merge(
+  const dbm_domaint &b,
+  locationt from,
+  locationt to)
+{
+  if(b.bottom)
+    return false;
+  if(bottom)
+  {
+    *this=b;
+    widening_count=0;
+    return true;
+  }
+  if(matrix.empty())
+    return false; // top
+  if(b.matrix.empty())
+  {
+    matrix.clear();
+    return true;
+  }
+
+  bool widen=from->location_number>=to->location_number &&
+    widening_count++>=DBM_WIDENING_DELAY;
+
+  bool changed=false;
+  std::size_t n=matrix.size();
+  for(std::size_t i=0; i<n; ++i)
+  {
+    for(std::size_t j=0; j<n; ++j)
+    {
+      boundt &a_ij=matrix[i][j];
+      const boundt &b_ij=b.matrix[i][j];
+      if(a_ij.inf)
+        continue;
+      if(b_ij.inf || b_ij.value>a_ij.value)
+      {
+        if(widen || b_ij.inf)
+          a_ij=boundt();
+        else
+          a_ij.value=b_ij.value;
+        changed=true;
+      }
+    }
+  }
+
+  // a widened matrix must not be closed to ensure termination
+  return changed;
+}
+
+/*******************************************************************\
+
+Function: dbm_domaint::output
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void dbm_domaint::output(
+  std::ostream &out,
+  const ai_baset &ai,
+  const namespacet &ns) const
+{
+  if(bottom)
+  {
+    out << "BOTTOM\n";
+    return;
+  }
+  if(matrix.empty())
+  {
+    out << "TOP\n";
+    return;
+  }
+
+  const dbm_analysist &dbm=static_cast<const dbm_analysist &>(ai);
+  std::vector<irep_idt> names(matrix.size());
+  for(const auto &v : dbm.var_map)
+    names[v.second]=v.first;
+
+  for(std::size_t i=0; i<matrix.size(); ++i)
+  {
+    for(std::size_t j=0; j<matrix.size(); ++j)
+    {
+      if(i==j || matrix[i][j].inf)
+        continue;
+      out << (i==0 ? "0" : id2string(names[i])) << " - "
+          << (j==0 ? "0" : id2string(names[j])) << " <= "
+          << matrix[i][j].value << "\n";
+    }
+  }
+}
+
+/*******************************************************************\
+
+Function: dbm_analysist::collect_vars
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void dbm_analysist::collect_vars(
+  const exprt &expr,
+  std::set<irep_idt> &vars,
+  std::set<irep_idt> &address_taken)
+{
+  if(expr.id()==ID_symbol)
+  {
+    vars.insert(to_symbol_expr(expr).get_identifier());
+    return;
+  }
+  if(expr.id()==ID_address_of)
+  {
+    std::set<irep_idt> objects;
+    collect_vars(to_address_of_expr(expr).object(), objects, address_taken);
+    address_taken.insert(objects.begin(), objects.end());
+    return;
+  }
+  forall_operands(it, expr)
+    collect_vars(*it, vars, address_taken);
+}
+
+/*******************************************************************\
+
+Function: dbm_analysist::initialize
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: tracks the local integer variables whose address
+          is not taken
+
+\*******************************************************************/
+
+void dbm_analysist::initialize(
+  const goto_functionst::goto_functiont &goto_function)
+{
+  ait<dbm_domaint>::initialize(goto_function);
+
+  std::set<irep_idt> vars, address_taken;
+  forall_goto_program_instructions(i_it, goto_function.body)
+  {
+    locations[i_it->location_number]=i_it;
+    collect_vars(i_it->code, vars, address_taken);
+    collect_vars(i_it->guard, vars, address_taken);
+  }
+
+  var_map.clear();
+  var_types.assign(1, typet());
+  var_lower.assign(1, 0);
+  var_upper.assign(1, 0);
+  for(const auto &id : vars)
+  {
+    if(address_taken.find(id)!=address_taken.end())
+      continue;
+    const symbolt *symbol;
+    if(ns.lookup(id, symbol) || symbol->is_static_lifetime)
+      continue;
+    mp_integer lower, upper;
+    if(!get_type_range(symbol->type, lower, upper))
+      continue;
+    var_map[id]=var_types.size();
+    var_types.push_back(symbol->type);
+    var_lower.push_back(lower);
+    var_upper.push_back(upper);
+  }
+
+  if(var_map.size()>max_vars)
+  {
+    var_map.clear();
+    var_types.resize(1);
+    var_lower.resize(1);
+    var_upper.resize(1);
+  }
+
+  if(!goto_function.body.instructions.empty())
+    operator[](goto_function.body.instructions.begin()).make_entry();
+}
+
+/*******************************************************************\
+
+Function: dbm_analysist::get_row_linear
+
+  Inputs:
+
+ Outputs: false if the row is not a sum of at most two variables
+          at the back edge of the same loop
+
+ Purpose:
+
+\*******************************************************************/
+
+bool dbm_analysist::get_row_linear(
+  const exprt &expr,
+  const typet &type,
+  int sign,
+  std::map<unsigned, int> &linear,
+  unsigned &location_number) const
+{
+  if(expr.id()==ID_symbol)
+  {
+    // x#lb<location number>, possibly with unwinding suffix
+    const std::string id=id2string(to_symbol_expr(expr).get_identifier());
+    std::size_t pos=id.rfind("#lb");
+    if(pos==std::string::npos)
+      return false;
+    var_mapt::const_iterator it=var_map.find(id.substr(0, pos));
+    if(it==var_map.end())
+      return false;
+    std::size_t end=pos+3;
+    while(end<id.size() && isdigit(id[end]))
+      end++;
+    if(end==pos+3)
+      return false;
+    unsigned loc=std::stoul(id.substr(pos+3, end-pos-3));
+    if(!linear.empty() && loc!=location_number)
+      return false;
+    location_number=loc;
+    linear[it->second]+=sign;
+    return true;
+  }
+  // intermediate results must be computed in the row type
+  //  in order to check for overflows
+  if(expr.type()!=type)
+    return false;
+  if(expr.id()==ID_typecast &&
+     to_typecast_expr(expr).op().id()==ID_symbol)
+  {
+    const exprt &op=to_typecast_expr(expr).op();
+    return get_row_linear(op, op.type(), sign, linear, location_number);
+  }
+  if(expr.id()==ID_unary_minus)
+    return get_row_linear(
+      to_unary_minus_expr(expr).op(), type, -sign, linear, location_number);
+  if((expr.id()==ID_plus || expr.id()==ID_minus) &&
+     expr.operands().size()==2)
+  {
+    return
+      get_row_linear(expr.op0(), type, sign, linear, location_number) &&
+      get_row_linear(
+        expr.op1(),
+        type,
+        expr.id()==ID_plus ? sign : -sign,
+        linear,
+        location_number);
+  }
+  return false;
+}
+
+/*******************************************************************\
+
+Function: dbm_analysist::get_row_bound
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: bound at the back edge is a bound for the loop row
+          as long as the row expression does not overflow
+
+\*******************************************************************/
+
+bool dbm_analysist::get_row_bound(
+  const local_SSAt &SSA,
+  const tpolyhedra_domaint::template_rowt &templ_row,
+  mp_integer &bound) const
+{
+  if(templ_row.kind!=domaint::LOOP)
+    return false;
+
+  std::map<unsigned, int> linear;
+  unsigned location_number=0;
+  if(!get_row_linear(
+       templ_row.expr, templ_row.expr.type(), 1, linear, location_number))
+    return false;
+
+  std::vector<std::pair<unsigned, int> > terms;
+  for(const auto &l : linear)
+  {
+    if(l.second<-1 || l.second>1)
+      return false;
+    if(l.second!=0)
+      terms.push_back(l);
+  }
+  if(terms.empty() || terms.size()>2)
+    return false;
+
+  std::map<unsigned, locationt>::const_iterator l_it=
+    locations.find(location_number);
+  if(l_it==locations.end())
+    return false;
+  state_mapt::const_iterator s_it=state_map.find(l_it->second);
+  if(s_it==state_map.end())
+    return false;
+  const dbm_domaint &state=s_it->second;
+  if(state.is_bottom())
+    return false;
+
+  // upper and lower bound of the linear expression
+  dbm_domaint::boundt upper, lower;
+  if(terms.size()==1)
+  {
+    unsigned x=terms[0].first;
+    bool pos=terms[0].second>0;
+    upper=state.get_bound(pos ? x : 0, pos ? 0 : x);
+    lower=state.get_bound(pos ? 0 : x, pos ? x : 0);
+  }
+  else if(terms[0].second!=terms[1].second)
+  {
+    unsigned x=terms[0].second>0 ? terms[0].first : terms[1].first;
+    unsigned y=terms[0].second>0 ? terms[1].first : terms[0].first;
+    upper=state.get_bound(x, y);
+    lower=state.get_bound(y, x);
+  }
+  else
+  {
+    bool pos=terms[0].second>0;
+    unsigned x=terms[0].first, y=terms[1].first;
+    dbm_domaint::boundt ux=state.get_bound(pos ? x : 0, pos ? 0 : x);
+    dbm_domaint::boundt uy=state.get_bound(pos ? y : 0, pos ? 0 : y);
+    dbm_domaint::boundt lx=state.get_bound(pos ? 0 : x, pos ? x : 0);
+    dbm_domaint::boundt ly=state.get_bound(pos ? 0 : y, pos ? y : 0);
+    if(!ux.inf && !uy.inf)
+      upper=dbm_domaint::boundt(ux.value+uy.value);
+    if(!lx.inf && !ly.inf)
+      lower=dbm_domaint::boundt(lx.value+ly.value);
+  }
+  if(upper.inf || lower.inf)
+    return false;
+
+  // all intermediate results must fit into the row type
+  mp_integer type_lower, type_upper;
+  if(!get_type_range(templ_row.expr.type(), type_lower, type_upper))
+    return false;
+  for(const auto &t : terms)
+  {
+    dbm_domaint::boundt u=state.get_bound(t.first, 0);
+    dbm_domaint::boundt l=state.get_bound(0, t.first);
+    mp_integer vu=u.inf ? var_upper[t.first] : u.value;
+    mp_integer vl=l.inf ? var_lower[t.first] : -l.value;
+    if(vl<type_lower || vu>type_upper || -vu<type_lower || -vl>type_upper)
+      return false;
+  }
+  if(-lower.value<type_lower || upper.value>type_upper)
+    return false;
+
+  bound=upper.value;
+  return true;
+}
@@ -0,0 +1,144 @@
+/*******************************************************************\
+
+Module: Zone (difference-bound matrix) abstract interpretation
+        used as pre-analysis for template polyhedra
+
+Author: Peter Schrammel
+
+\*******************************************************************/
+
+#ifndef CPROVER_2LS_DOMAINS_DBM_ANALYSIS_H
+#define CPROVER_2LS_DOMAINS_DBM_ANALYSIS_H
+
+#include <map>
+#include <vector>
+
+#include <util/mp_arith.h>
+#include <analyses/ai.h>
+
+#include <ssa/local_ssa.h>
+
+#include "tpolyhedra_domain.h"
+
+class dbm_analysist;
+
+class dbm_domaint:public ai_domain_baset
+{
+public:
+  // x_i-x_j<=m[i][j], x_0 is the constant 0
+  struct boundt
+  {
+    bool inf;
+    mp_integer value;
+
+    boundt():inf(true) {}
+    explicit boundt(const mp_integer &_value):inf(false), value(_value) {}
+  };
+  typedef std::vector<std::vector<boundt> > matrixt;
+
+  dbm_domaint():
+    bottom(true),
+    widening_count(0)
+  {
+  }
+
+  virtual void transform(locationt, locationt, ai_baset &, const namespacet &);
+  virtual void output(
+    std::ostream &,
+    const ai_baset &,
+    const namespacet &) const;
+  bool merge(const dbm_domaint &, locationt, locationt);
+
+  virtual void make_bottom() { bottom=true; }
+  virtual void make_top() { bottom=false; matrix.clear(); }
+  virtual void make_entry() { make_top(); }
+
+  bool is_bottom() const { return bottom; }
+
+  // upper bound of x_i-x_j
+  boundt get_bound(unsigned i, unsigned j) const;
+
+protected:
+  bool bottom;
+  matrixt matrix; // empty: top
+  unsigned widening_count;
+
+  void init_matrix(const dbm_analysist &dbm);
+  void close();
+  void havoc(unsigned var, const dbm_analysist &dbm);
+  void add_constraint(unsigned i, unsigned j, const mp_integer &c);
+  void get_interval(
+    unsigned var,
+    const dbm_analysist &dbm,
+    mp_integer &lower,
+    mp_integer &upper) const;
+
+  bool get_interval(
+    const exprt &expr,
+    const dbm_analysist &dbm,
+    mp_integer &lower,
+    mp_integer &upper) const;
+  bool get_linear(
+    const exprt &expr,
+    const dbm_analysist &dbm,
+    unsigned &var,
+    mp_integer &c) const;
+
+  void assign(unsigned var, const exprt &rhs, const dbm_analysist &dbm);
+  void assume(const exprt &cond, const dbm_analysist &dbm);
+};
+
+class dbm_analysist:public ait<dbm_domaint>
+{
+public:
+  typedef std::map<irep_idt, unsigned> var_mapt;
+
+  dbm_analysist(
+    const goto_functionst::goto_functiont &goto_function,
+    const namespacet &_ns):
+    ns(_ns)
+  {
+    operator()(goto_function, _ns);
+  }
+
+  // bound on the value of a loop template row at the back edge
+  //  of the loop, returns false if there is none
+  bool get_row_bound(
+    const local_SSAt &SSA,
+    const tpolyhedra_domaint::template_rowt &templ_row,
+    mp_integer &bound) const;
+
+  // larger functions are not analysed
+  static const unsigned max_vars=48;
+
+protected:
+  const namespacet &ns;
+
+  var_mapt var_map;
+  std::vector<typet> var_types; // index 0 unused
+  std::vector<mp_integer> var_lower, var_upper; // type ranges
+
+  virtual void initialize(
+    const goto_functionst::goto_functiont &goto_function) override;
+
+  void collect_vars(
+    const exprt &expr,
+    std::set<irep_idt> &vars,
+    std::set<irep_idt> &address_taken);
+
+  bool get_row_linear(
+    const exprt &expr,
+    const typet &type,
+    int sign,
+    std::map<unsigned, int> &linear,
+    unsigned &location_number) const;
+
+  std::map<unsigned, locationt> locations;
+
+  friend class dbm_domaint;
+};
+
+// range of a bitvector type
+bool get_type_range(const typet &type, mp_integer &lower, mp_integer &upper);
+
+#endif
@@ -60,6 +60,9 @@ public:
 
   typedef std::vector<var_spect> var_specst;
 
+  // pairs of indices into var_specst, the smaller index first
+  typedef std::set<std::pair<std::size_t, std::size_t> > var_pairst;
+
   // handles on values to retrieve from model
   bvt strategy_cond_literals;
   exprt::operandst strategy_value_exprs;
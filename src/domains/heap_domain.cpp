@@ -45,6 +45,47 @@ void heap_domaint::initialize(domaint::valuet &value)
 
 /*******************************************************************\
 
+Function: heap_domaint::restore_value
+
+  Inputs: template and value of a previous analysis
+
+ Outputs: true if the value has been taken
+
+ Purpose: Rows refer to each other by their indices, hence the value
+          is only taken if the template is the same.
+
+\*******************************************************************/
+
+bool heap_domaint::restore_value(
+  const templatet &old_templ,
+  const heap_valuet &old_value,
+  heap_valuet &value) const
+{
+  if(old_templ.size()!=templ.size() || old_value.size()!=templ.size())
+    return false;
+
+  for(rowt row=0; row<templ.size(); ++row)
+  {
+    const template_rowt &old_templ_row=old_templ[row];
+    if(old_templ_row.expr!=templ[row].expr ||
+       old_templ_row.pre_guard!=templ[row].pre_guard ||
+       old_templ_row.post_guard!=templ[row].post_guard ||
+       old_templ_row.aux_expr!=templ[row].aux_expr ||
+       old_templ_row.kind!=templ[row].kind ||
+       old_templ_row.mem_kind!=templ[row].mem_kind ||
+       old_templ_row.dyn_obj!=templ[row].dyn_obj ||
+       old_templ_row.member!=templ[row].member)
+      return false;
+  }
+
+  assert(value.size()==templ.size());
+  for(rowt row=0; row<templ.size(); ++row)
+    value.at(row).reset(old_value[row].clone());
+  return true;
+}
+
+/*******************************************************************\
+
 Function: heap_domaint::make_template
 
   Inputs:
@@ -75,6 +75,8 @@ public:
 
     virtual void clear()=0;
 
+    virtual row_valuet *clone() const=0;
+
     virtual ~row_valuet() {}
   };
 
@@ -101,6 +103,11 @@ public:
     }
 
     virtual void clear() override;
+
+    virtual row_valuet *clone() const override
+    {
+      return new stack_row_valuet(*this);
+    }
   };
 
   /*******************************************************************\
@@ -166,6 +173,11 @@ public:
 
     virtual void clear() override;
 
+    virtual row_valuet *clone() const override
+    {
+      return new heap_row_valuet(*this);
+    }
+
     bool add_path(const exprt &dest, const dyn_objt &dyn_obj);
 
     bool add_all_paths(
@@ -262,6 +274,15 @@ public:
     return templ.empty();
   }
 
+  const templatet &get_template() const { return templ; }
+
+  // warm start: takes the given value if it has been computed
+  //  for the same template
+  bool restore_value(
+    const templatet &old_templ,
+    const heap_valuet &old_value,
+    heap_valuet &value) const;
+
   virtual std::vector<std::string> identify_invariant_imprecision(
     const valuet &value) override;
 
@@ -11,8 +11,11 @@ Author: Peter Schrammel
 #endif
 
 #include <set>
+#include <algorithm>
+#include <chrono>
 
 #include <solvers/flattening/bv_pointers.h>
+#include <solvers/sat/cnf.h>
 #include <util/i2string.h>
 
 #include "incremental_solver.h"
@@ -53,6 +56,13 @@ void incremental_solvert::new_context()
   activation_literals.push_back(activation_literal);
   solver->set_assumptions(activation_literals);
 
+  if(is_compacting())
+  {
+    contexts.push_back(constraintst());
+    context_clauses.push_back(
+      std::make_pair(get_number_of_clauses(), dead_clauses));
+  }
+
 #if 0
   return !activation_literals.back(); // not to be used anymore
 #endif
@@ -98,6 +108,19 @@ void incremental_solvert::pop_context()
 #endif
 
   solver->set_assumptions(activation_literals);
+
+  if(is_compacting())
+  {
+    assert(contexts.size()>=2 && !context_clauses.empty());
+    contexts.pop_back();
+    // all clauses added since the context was created are dead now
+    dead_clauses=context_clauses.back().second+
+      (get_number_of_clauses()-context_clauses.back().first);
+    context_clauses.pop_back();
+
+    if(activation_literals.empty() && dead_clauses>compaction_threshold)
+      compact();
+  }
 #endif
 }
 
@@ -135,11 +158,171 @@ void incremental_solvert::make_context_permanent()
 #endif
 
   solver->set_assumptions(activation_literals);
+
+  if(is_compacting())
+  {
+    assert(contexts.size()>=2 && !context_clauses.empty());
+    contextst::iterator c_it=contexts.end(); c_it--; c_it--;
+    c_it->splice(c_it->end(), contexts.back());
+    contexts.pop_back();
+    context_clauses.pop_back();
+  }
 #endif
 }
 
 /*******************************************************************\
 
+Function: incremental_solvert::profiled_call
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: solver call that is recorded by the solver profiler
+
+\*******************************************************************/
+
+decision_proceduret::resultt incremental_solvert::profiled_call()
+{
+  unsigned long variables=sat_check->no_variables();
+  unsigned long clauses=get_number_of_clauses();
+
+  std::chrono::steady_clock::time_point start=
+    std::chrono::steady_clock::now();
+  decision_proceduret::resultt result=(*solver)();
+  std::chrono::duration<double> time=
+    std::chrono::steady_clock::now()-start;
+
+  // the formula is only extended between calls,
+  //  except for refinement, which is attributed to this call
+  unsigned long variables_after=sat_check->no_variables();
+  unsigned long clauses_after=get_number_of_clauses();
+  solver_profilert::record(
+    time.count(),
+    variables_after-std::min(profiled_variables, variables),
+    clauses_after-std::min(profiled_clauses, clauses),
+    activation_literals.size(),
+    result);
+  profiled_variables=variables_after;
+  profiled_clauses=clauses_after;
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: incremental_solvert::convert_context_constraint
+
+  Inputs: constraint of the current context
+
+ Outputs: its literal
+
+ Purpose: converts the constraint and counts whether the solver
+          reuses the literal of an earlier conversion
+
+\*******************************************************************/
+
+literalt incremental_solvert::convert_context_constraint(const exprt &expr)
+{
+  if(expr.id()!=ID_symbol && expr.id()!=ID_constant)
+  {
+    const prop_conv_solvert::cachet &cache=
+      static_cast<prop_conv_solvert *>(solver)->get_cache();
+    context_conversions++;
+    if(cache.find(expr)!=cache.end())
+      reused_literals++;
+  }
+  return solver->convert(expr);
+}
+
+/*******************************************************************\
+
+Function: incremental_solvert::get_number_of_clauses
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+unsigned long incremental_solvert::get_number_of_clauses() const
+{
+  const cnft *cnf=dynamic_cast<const cnft *>(sat_check);
+  return cnf==NULL ? 0 : cnf->no_clauses();
+}
+
+/*******************************************************************\
+
+Function: has_literal
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static bool has_literal(const exprt &expr)
+{
+  if(expr.id()==ID_literal)
+    return true;
+  forall_operands(it, expr)
+    if(has_literal(*it))
+      return true;
+  return false;
+}
+
+/*******************************************************************\
+
+Function: incremental_solvert::compact
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: replaces the SAT instance by a fresh one that only
+          contains the permanent constraints; called when no
+          context is open, so that no literal handed out for a
+          popped context can be used any more
+
+\*******************************************************************/
+
+void incremental_solvert::compact()
+{
+  assert(activation_literals.empty() && contexts.size()==1);
+
+  // literals of the old instance cannot be replayed
+  for(const auto &constraint : contexts.front())
+  {
+    if(has_literal(constraint))
+    {
+      debug() << "Solver compaction disabled: "
+              << "permanent constraint refers to literals" << eom;
+      compaction_threshold=0;
+      contexts.front().clear();
+      return;
+    }
+  }
+
+  debug() << "Compacting solver: dropping " << dead_clauses
+          << " of " << get_number_of_clauses() << " clauses" << eom;
+
+  deallocate_solvers();
+  allocate_solvers(arith_refinement);
+  for(const auto &constraint : contexts.front())
+    *solver << constraint;
+
+  dead_clauses=0;
+  profiled_variables=0;
+  profiled_clauses=0;
+  rebuilds++;
+}
+
+/*******************************************************************\
+
 Function: incremental_solvert::debug_add_to_formula
 
   Inputs:
@@ -10,6 +10,7 @@ Author: Peter Schrammel
 #define CPROVER_2LS_DOMAINS_INCREMENTAL_SOLVER_H
 
 #include <map>
+#include <vector>
 #include <iostream>
 
 #include <solvers/flattening/bv_pointers.h>
@@ -18,6 +19,7 @@ Author: Peter Schrammel
 
 #include "domain.h"
 #include "util.h"
+#include "solver_profiler.h"
 
 // #define DISPLAY_FORMULA
 // #define NO_ARITH_REFINEMENT
@@ -42,7 +44,14 @@ class incremental_solvert:public messaget
     activation_literal_counter(0),
     domain_number(0),
     arith_refinement(_arith_refinement),
-    solver_calls(0)
+    solver_calls(0),
+    profiled_variables(0),
+    profiled_clauses(0),
+    compaction_threshold(0),
+    dead_clauses(0),
+    rebuilds(0),
+    context_conversions(0),
+    reused_literals(0)
   {
     allocate_solvers(_arith_refinement);
     contexts.push_back(constraintst());
@@ -95,6 +104,9 @@ class incremental_solvert:public messaget
 #endif
 #endif
 
+    if(solver_profilert::is_enabled())
+      return profiled_call();
+
     return (*solver)();
   }
 
@@ -103,6 +115,22 @@ class incremental_solvert:public messaget
   literalt convert(const exprt& expr) { return solver->convert(expr); }
 
   unsigned get_number_of_solver_calls() { return solver_calls; }
+  unsigned get_number_of_rebuilds() { return rebuilds; }
+  unsigned get_number_of_context_conversions()
+  {
+    return context_conversions;
+  }
+  unsigned get_number_of_reused_literals() { return reused_literals; }
+
+  literalt convert_context_constraint(const exprt &expr);
+
+  // rebuild the solver from the live constraints when the popped
+  //  contexts hold more than the given number of clauses (0: never)
+  void set_compaction_threshold(unsigned long threshold)
+  {
+    compaction_threshold=threshold;
+  }
+  bool is_compacting() const { return compaction_threshold>0; }
 
   unsigned next_domain_number() { return domain_number++; }
 
@@ -130,7 +158,8 @@ class incremental_solvert:public messaget
   // context assumption literals
   bvt activation_literals;
 
-  // non-incremental solving
+  // non-incremental solving, and replaying the live constraints
+  //  when compacting
   contextst contexts;
 
  protected:
@@ -141,6 +170,27 @@ class incremental_solvert:public messaget
   // statistics
   unsigned solver_calls;
 
+  // formula size at the end of the previous profiled call
+  unsigned long profiled_variables;
+  unsigned long profiled_clauses;
+
+  decision_proceduret::resultt profiled_call();
+
+  // compaction
+  unsigned long compaction_threshold;
+  unsigned long dead_clauses;
+  // clauses and dead clauses when the open contexts were created
+  std::vector<std::pair<unsigned long, unsigned long> > context_clauses;
+  unsigned rebuilds;
+
+  // constraints added in a context, and how many of them the cache
+  //  of the solver has converted before
+  unsigned context_conversions;
+  unsigned reused_literals;
+
+  unsigned long get_number_of_clauses() const;
+  void compact();
+
   void allocate_solvers(bool arith_refinement)
   {
     sat_check=new satcheckt();
@@ -196,9 +246,12 @@ static inline incremental_solvert &operator<<(
   dest.contexts.back().push_back(src);
 #else
 #ifndef DEBUG_FORMULA
+  if(dest.is_compacting())
+    dest.contexts.back().push_back(src);
   if(!dest.activation_literals.empty())
-    *dest.solver <<
-      or_exprt(src, literal_exprt(!dest.activation_literals.back()));
+    dest.sat_check->lcnf(
+      dest.convert_context_constraint(src),
+      !dest.activation_literals.back());
   else
     *dest.solver << src;
 #else
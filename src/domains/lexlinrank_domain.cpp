@@ -30,6 +30,70 @@ Author: Peter Schrammel
 
 /*******************************************************************\
 
+Function: lexlinrank_domaint::~lexlinrank_domaint
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+lexlinrank_domaint::~lexlinrank_domaint()
+{
+  for(auto &inner_solver : inner_solvers)
+    delete inner_solver;
+}
+
+/*******************************************************************\
+
+Function: lexlinrank_domaint::get_inner_solver
+
+  Inputs: template row
+
+ Outputs: the inner solver of the row
+
+ Purpose: the solvers are allocated on first use and kept until the
+          domain is destroyed
+
+\*******************************************************************/
+
+incremental_solvert &lexlinrank_domaint::get_inner_solver(const rowt &row)
+{
+  if(inner_solvers.size()<=row)
+    inner_solvers.resize(row+1, NULL);
+  if(inner_solvers[row]==NULL)
+  {
+    inner_solvers[row]=incremental_solvert::allocate(ns);
+    inner_solvers[row]->new_context();
+  }
+  return *inner_solvers[row];
+}
+
+/*******************************************************************\
+
+Function: lexlinrank_domaint::reset_inner_solver
+
+  Inputs: template row
+
+ Outputs:
+
+ Purpose: drops the constraints of the row instead of
+          re-allocating its solver
+
+\*******************************************************************/
+
+void lexlinrank_domaint::reset_inner_solver(const rowt &row)
+{
+  if(inner_solvers.size()<=row || inner_solvers[row]==NULL)
+    return;
+  inner_solvers[row]->pop_context();
+  inner_solvers[row]->new_context();
+}
+
+/*******************************************************************\
+
 Function: lexlinrank_domaint::initialize
 
   Inputs:
@@ -57,8 +121,8 @@ const exprt lexlinrank_domaint::initialize_solver(
   const exprt &precondition,
   template_generator_baset &template_generator)
 {
-  delete inner_solver;
-  inner_solver=incremental_solvert::allocate(ns);
+  for(std::size_t row=0; row<inner_solvers.size(); ++row)
+    reset_inner_solver(row);
 
   return true_exprt();
 }
@@ -67,6 +131,7 @@ bool lexlinrank_domaint::edit_row(const rowt &row, valuet &inv, bool improved)
 {
   lexlinrank_domaint::templ_valuet &rank=
     static_cast<lexlinrank_domaint::templ_valuet &>(inv);
+  solver_profilert::phaset profiler_phase("ranking");
   lexlinrank_domaint::row_valuet symb_values;
   symb_values.resize(rank[row].size());
 
@@ -80,26 +145,27 @@ bool lexlinrank_domaint::edit_row(const rowt &row, valuet &inv, bool improved)
     refinement_constraint);
 
   simplify_expr(constraint, ns);
-  *inner_solver << constraint;
+  incremental_solvert &inner_solver=get_inner_solver(row);
+  inner_solver << constraint;
 
   exprt rounding_mode=symbol_exprt(
     CPROVER_PREFIX "rounding_mode",
     signedbv_typet(32));
 
   // set rounding mode
-  *inner_solver << equal_exprt(
+  inner_solver << equal_exprt(
     rounding_mode,
     from_integer(mp_integer(0), signedbv_typet(32)));
 
   // refinement
   if(!refinement_constraint.is_true())
   {
-    inner_solver->new_context();
-    *inner_solver << refinement_constraint;
+    inner_solver.new_context();
+    inner_solver << refinement_constraint;
   }
 
   // solve
-  bool inner_solver_result=(*inner_solver)();
+  decision_proceduret::resultt inner_solver_result=inner_solver();
   if(inner_solver_result==decision_proceduret::D_SATISFIABLE &&
      number_inner_iterations<max_inner_iterations)
   {
@@ -117,7 +183,7 @@ bool lexlinrank_domaint::edit_row(const rowt &row, valuet &inv, bool improved)
       // get the model for all c
       for(auto &e : c)
       {
-        exprt v=inner_solver->solver->get(e);
+        exprt v=inner_solver.solver->get(e);
         new_row_values[constraint_no].c.push_back(v);
       }
     }
@@ -128,16 +194,16 @@ bool lexlinrank_domaint::edit_row(const rowt &row, valuet &inv, bool improved)
     set_row_value(row, new_row_values, rank);
 
     if(!refinement_constraint.is_true())
-      inner_solver->pop_context();
+      inner_solver.pop_context();
   }
   else
   {
+    if(!refinement_constraint.is_true())
+      inner_solver.pop_context();
+
     if(refine())
     {
       improved=true; // refinement possible
-
-      if(!refinement_constraint.is_true())
-        inner_solver->pop_context();
     }
     else
     {
@@ -150,8 +216,7 @@ bool lexlinrank_domaint::edit_row(const rowt &row, valuet &inv, bool improved)
       else
       {
         number_elements_per_row[row]++;
-        delete inner_solver;
-        inner_solver=incremental_solvert::allocate(ns);
+        reset_inner_solver(row);
         reset_refinements();
 
         add_element(row, rank);
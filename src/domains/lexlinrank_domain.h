@@ -61,9 +61,9 @@ public:
     max_inner_iterations(_max_inner_iterations),
     number_inner_iterations(0)
     {
-      inner_solver=incremental_solvert::allocate(_ns);
     }
 
+  virtual ~lexlinrank_domaint();
 
   // initialize value
   virtual void initialize(valuet &value);
@@ -136,11 +136,18 @@ public:
   // the "inner" solver
   const unsigned max_elements; // lexicographic components
   const unsigned max_inner_iterations;
-  incremental_solvert *inner_solver;
   unsigned number_inner_iterations;
 
 protected:
   pre_post_valuest values;
+
+  // the "inner" solvers, one per row, such that each one only holds
+  //  the constraints on the coefficients of its row;
+  //  these constraints are in a context that is replaced when
+  //  a lexicographic component is added to the row
+  std::vector<incremental_solvert *> inner_solvers;
+  incremental_solvert &get_inner_solver(const rowt &row);
+  void reset_inner_solver(const rowt &row);
   bool is_row_value_false(const row_valuet & row_value) const;
   bool is_row_value_true(const row_valuet & row_value) const;
   bool is_row_element_value_false(
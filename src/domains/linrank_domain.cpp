@@ -30,6 +30,46 @@ Author: Peter Schrammel
 
 /*******************************************************************\
 
+Function: linrank_domaint::~linrank_domaint
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+linrank_domaint::~linrank_domaint()
+{
+  for(auto &inner_solver : inner_solvers)
+    delete inner_solver;
+}
+
+/*******************************************************************\
+
+Function: linrank_domaint::get_inner_solver
+
+  Inputs: template row
+
+ Outputs: the inner solver of the row
+
+ Purpose: the solvers are allocated on first use and kept until the
+          domain is destroyed
+
+\*******************************************************************/
+
+incremental_solvert &linrank_domaint::get_inner_solver(const rowt &row)
+{
+  if(inner_solvers.size()<=row)
+    inner_solvers.resize(row+1, NULL);
+  if(inner_solvers[row]==NULL)
+    inner_solvers[row]=incremental_solvert::allocate(ns);
+  return *inner_solvers[row];
+}
+
+/*******************************************************************\
+
 Function: linrank_domaint::initialize
 
   Inputs:
@@ -73,6 +113,7 @@ bool linrank_domaint::edit_row(const rowt &row, valuet &inv, bool improved)
 {
   linrank_domaint::templ_valuet &rank=
     static_cast<linrank_domaint::templ_valuet &>(inv);
+  solver_profilert::phaset profiler_phase("ranking");
   exprt rounding_mode=symbol_exprt(
     CPROVER_PREFIX "rounding_mode",
     signedbv_typet(32));
@@ -86,19 +127,20 @@ bool linrank_domaint::edit_row(const rowt &row, valuet &inv, bool improved)
     symb_values, row, refinement_constraint);
   simplify_expr(constraint, ns);
 
-  *inner_solver << equal_exprt(
+  incremental_solvert &inner_solver=get_inner_solver(row);
+  inner_solver << equal_exprt(
     rounding_mode, from_integer(mp_integer(0), signedbv_typet(32)));
-  *inner_solver << constraint;
+  inner_solver << constraint;
 
   // refinement
   if(!refinement_constraint.is_true())
   {
-    inner_solver->new_context();
-    *inner_solver << refinement_constraint;
+    inner_solver.new_context();
+    inner_solver << refinement_constraint;
   }
 
   // solve
-  if((*inner_solver)()==decision_proceduret::D_SATISFIABLE &&
+  if(inner_solver()==decision_proceduret::D_SATISFIABLE &&
     number_inner_iterations<max_inner_iterations)
   {
     std::vector<exprt> c=symb_values.c;
@@ -109,10 +151,10 @@ bool linrank_domaint::edit_row(const rowt &row, valuet &inv, bool improved)
     // get the model for all c
     for(const auto &e : c)
     {
-      exprt v=inner_solver->solver->get(e);
+      exprt v=inner_solver.solver->get(e);
       new_row_values.c.push_back(v);
     }
-    exprt rmv=inner_solver->solver->get(rounding_mode);
+    exprt rmv=inner_solver.solver->get(rounding_mode);
 
     // update the current template
     set_row_value(row, new_row_values, rank);
@@ -134,7 +176,7 @@ bool linrank_domaint::edit_row(const rowt &row, valuet &inv, bool improved)
   }
 
   if(!refinement_constraint.is_true())
-    inner_solver->pop_context();
+    inner_solver.pop_context();
 
   return improved;
 }
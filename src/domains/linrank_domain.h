@@ -59,8 +59,10 @@ public:
     max_inner_iterations(_max_inner_iterations),
     number_inner_iterations(0)
   {
-    inner_solver=incremental_solvert::allocate(_ns);
   }
+
+  virtual ~linrank_domaint();
+
   // initialize value
   virtual void initialize(valuet &value);
 
@@ -120,13 +122,16 @@ public:
   // the "inner" solver
   const unsigned max_elements; // lexicographic components
   const unsigned max_inner_iterations;
-  incremental_solvert *inner_solver;
   unsigned number_inner_iterations;
 
-
 protected:
   pre_post_valuest values;
 
+  // the "inner" solvers, one per row, such that each one only holds
+  //  the constraints on the coefficients of its row
+  std::vector<incremental_solvert *> inner_solvers;
+  incremental_solvert &get_inner_solver(const rowt &row);
+
   bool is_row_value_false(const row_valuet & row_value) const;
   bool is_row_value_true(const row_valuet & row_value) const;
 public:
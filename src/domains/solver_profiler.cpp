@@ -0,0 +1,202 @@
+/*******************************************************************\
+
+Module: Profiling of Solver Calls
+
+Author: Peter Schrammel
+
+\*******************************************************************/
+
+#include <iostream>
+#include <sstream>
+#include <cstdlib>
+
+#include <util/json.h>
+
+#include "solver_profiler.h"
+
+bool solver_profilert::enabled=false;
+std::string solver_profilert::current_function="";
+std::string solver_profilert::current_phase="";
+solver_profilert::entriest solver_profilert::entries;
+
+/*******************************************************************\
+
+Function: solver_profilert::record
+
+  Inputs: wall time of the call, formula size added since the
+          previous call, number of open contexts, result
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void solver_profilert::record(
+  double time,
+  unsigned long variables,
+  unsigned long clauses,
+  unsigned depth,
+  decision_proceduret::resultt result)
+{
+  entryt &entry=entries[keyt(
+    current_function.empty() ? "<none>" : current_function,
+    current_phase.empty() ? "other" : current_phase)];
+
+  entry.calls++;
+  if(result==decision_proceduret::D_SATISFIABLE)
+    entry.sat++;
+  else if(result==decision_proceduret::D_UNSATISFIABLE)
+    entry.unsat++;
+  entry.time+=time;
+  if(time>entry.max_time)
+    entry.max_time=time;
+  entry.variables+=variables;
+  entry.clauses+=clauses;
+  if(depth>entry.max_depth)
+    entry.max_depth=depth;
+}
+
+/*******************************************************************\
+
+Function: double2string
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static std::string double2string(double d)
+{
+  std::ostringstream s;
+  s.precision(6);
+  s << std::fixed << d;
+  return s.str();
+}
+
+/*******************************************************************\
+
+Function: solver_profilert::output_json
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: one object per function with one entry per phase
+
+\*******************************************************************/
+
+void solver_profilert::output_json(std::ostream &out)
+{
+  json_objectt json;
+  json_arrayt &functions=json["functions"].make_array();
+
+  unsigned total_calls=0;
+  double total_time=0;
+
+  // entries are sorted by function
+  json_arrayt *phases=NULL;
+  std::string last_function;
+  for(const auto &e : entries)
+  {
+    if(phases==NULL || e.first.first!=last_function)
+    {
+      json_objectt &function=functions.push_back().make_object();
+      function["name"]=json_stringt(e.first.first);
+      phases=&function["phases"].make_array();
+      last_function=e.first.first;
+    }
+
+    const entryt &entry=e.second;
+    json_objectt &phase=phases->push_back().make_object();
+    phase["phase"]=json_stringt(e.first.second);
+    phase["calls"]=json_numbert(std::to_string(entry.calls));
+    phase["sat"]=json_numbert(std::to_string(entry.sat));
+    phase["unsat"]=json_numbert(std::to_string(entry.unsat));
+    phase["time"]=json_numbert(double2string(entry.time));
+    phase["maxTime"]=json_numbert(double2string(entry.max_time));
+    phase["variables"]=json_numbert(std::to_string(entry.variables));
+    phase["clauses"]=json_numbert(std::to_string(entry.clauses));
+    phase["maxContextDepth"]=json_numbert(std::to_string(entry.max_depth));
+
+    total_calls+=entry.calls;
+    total_time+=entry.time;
+  }
+
+  json["calls"]=json_numbert(std::to_string(total_calls));
+  json["time"]=json_numbert(double2string(total_time));
+
+  out << json << '\n';
+}
+
+/*******************************************************************\
+
+Function: solver_profilert::to_irep
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+irept solver_profilert::to_irep()
+{
+  irept irep;
+  irept::subt &subs=irep.get_sub();
+  for(const auto &e : entries)
+  {
+    const entryt &entry=e.second;
+    irept i;
+    i.set("function", e.first.first);
+    i.set("phase", e.first.second);
+    i.set("calls", entry.calls);
+    i.set("sat", entry.sat);
+    i.set("unsat", entry.unsat);
+    i.set("time", double2string(entry.time));
+    i.set("max_time", double2string(entry.max_time));
+    i.set("variables", std::to_string(entry.variables));
+    i.set("clauses", std::to_string(entry.clauses));
+    i.set("max_depth", entry.max_depth);
+    subs.push_back(i);
+  }
+  return irep;
+}
+
+/*******************************************************************\
+
+Function: solver_profilert::merge
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: adds the profile of a worker process
+
+\*******************************************************************/
+
+void solver_profilert::merge(const irept &irep)
+{
+  for(const auto &i : irep.get_sub())
+  {
+    entryt &entry=entries[keyt(
+      id2string(i.get("function")), id2string(i.get("phase")))];
+    entry.calls+=i.get_unsigned_int("calls");
+    entry.sat+=i.get_unsigned_int("sat");
+    entry.unsat+=i.get_unsigned_int("unsat");
+    entry.time+=std::atof(i.get_string("time").c_str());
+    double max_time=std::atof(i.get_string("max_time").c_str());
+    if(max_time>entry.max_time)
+      entry.max_time=max_time;
+    entry.variables+=
+      std::strtoul(i.get_string("variables").c_str(), NULL, 10);
+    entry.clauses+=
+      std::strtoul(i.get_string("clauses").c_str(), NULL, 10);
+    if(i.get_unsigned_int("max_depth")>entry.max_depth)
+      entry.max_depth=i.get_unsigned_int("max_depth");
+  }
+}
@@ -0,0 +1,106 @@
+/*******************************************************************\
+
+Module: Profiling of Solver Calls
+
+Author: Peter Schrammel
+
+\*******************************************************************/
+
+#ifndef CPROVER_2LS_DOMAINS_SOLVER_PROFILER_H
+#define CPROVER_2LS_DOMAINS_SOLVER_PROFILER_H
+
+#include <map>
+#include <string>
+#include <iosfwd>
+
+#include <util/irep.h>
+#include <solvers/prop/decision_procedure.h>
+
+// Collects statistics about the solver calls of the whole process,
+//  broken down by the function under analysis and by the phase of
+//  the analysis (improvement check, binary search, ...). Both are
+//  set by the callers through the scoped tags below.
+class solver_profilert
+{
+public:
+  struct entryt
+  {
+    unsigned calls;
+    unsigned sat;
+    unsigned unsat;
+    double time; // wall time in seconds
+    double max_time;
+    unsigned long variables; // added since the previous call
+    unsigned long clauses;
+    unsigned max_depth; // of the activation literal stack
+
+    entryt():
+      calls(0), sat(0), unsat(0),
+      time(0), max_time(0),
+      variables(0), clauses(0),
+      max_depth(0)
+    {
+    }
+  };
+
+  // (function, phase)
+  typedef std::pair<std::string, std::string> keyt;
+  typedef std::map<keyt, entryt> entriest;
+
+  static void enable() { enabled=true; }
+  static bool is_enabled() { return enabled; }
+
+  static void record(
+    double time,
+    unsigned long variables,
+    unsigned long clauses,
+    unsigned depth,
+    decision_proceduret::resultt result);
+
+  static void output_json(std::ostream &out);
+
+  // for transferring the profile from worker processes
+  static irept to_irep();
+  static void merge(const irept &irep);
+  static void clear() { entries.clear(); }
+
+  // tags the solver calls in its lifetime with a phase
+  class phaset
+  {
+  public:
+    explicit phaset(const std::string &phase):
+      previous(current_phase)
+    {
+      current_phase=phase;
+    }
+
+    ~phaset() { current_phase=previous; }
+
+  protected:
+    std::string previous;
+  };
+
+  // tags the solver calls in its lifetime with a function
+  class functiont
+  {
+  public:
+    explicit functiont(const irep_idt &function):
+      previous(current_function)
+    {
+      current_function=id2string(function);
+    }
+
+    ~functiont() { current_function=previous; }
+
+  protected:
+    std::string previous;
+  };
+
+protected:
+  static bool enabled;
+  static std::string current_function;
+  static std::string current_phase;
+  static entriest entries;
+};
+
+#endif
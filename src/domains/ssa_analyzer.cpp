@@ -27,10 +27,15 @@ Author: Peter Schrammel
 #include "strategy_solver_heap_tpolyhedra.h"
 #include "strategy_solver_heap_tpolyhedra_sympath.h"
 #include "strategy_solver.h"
+#include "dbm_analysis.h"
+
+#include <ssa/ssa_slicer.h>
 
 // NOLINTNEXTLINE(*)
 #define BINSEARCH_SOLVER strategy_solver_binsearcht(\
-  *static_cast<tpolyhedra_domaint *>(domain), solver, SSA.ns)
+  *static_cast<tpolyhedra_domaint *>(domain), solver, SSA.ns, \
+  template_generator.options.get_bool_option("binsearch-multi-row"), \
+  template_generator.options.get_bool_option("binsearch-gallop"))
 #if 0
 // NOLINTNEXTLINE(*)
 #define BINSEARCH_SOLVER strategy_solver_binsearch2t(\
@@ -55,6 +60,101 @@ Author: Peter Schrammel
 
 /*******************************************************************\
 
+Function: collect_thresholds_rec
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static void collect_thresholds_rec(
+  const exprt &expr,
+  std::set<mp_integer> &thresholds)
+{
+  if(expr.id()==ID_constant &&
+     (expr.type().id()==ID_signedbv || expr.type().id()==ID_unsignedbv))
+  {
+    mp_integer c;
+    if(!to_integer(expr, c))
+    {
+      // bounds of x<c, x<=c, -x<-c, -x<=-c
+      thresholds.insert(c);
+      thresholds.insert(c+1);
+      thresholds.insert(-c);
+      thresholds.insert(-c+1);
+    }
+    return;
+  }
+  forall_operands(it, expr)
+    collect_thresholds_rec(*it, thresholds);
+}
+
+/*******************************************************************\
+
+Function: ssa_analyzert::collect_thresholds
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: collects integer constants occurring in the SSA as
+          candidate row values for the galloping search
+
+\*******************************************************************/
+
+void ssa_analyzert::collect_thresholds(
+  const local_SSAt &SSA,
+  std::set<mp_integer> &thresholds)
+{
+  for(const auto &node : SSA.nodes)
+  {
+    for(const auto &e : node.equalities)
+      collect_thresholds_rec(e, thresholds);
+    for(const auto &c : node.constraints)
+      collect_thresholds_rec(c, thresholds);
+    for(const auto &a : node.assertions)
+      collect_thresholds_rec(a, thresholds);
+  }
+}
+
+/*******************************************************************\
+
+Function: ssa_analyzert::get_dbm_row_bounds
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: bounds for the loop rows of the template from a zone
+          analysis of the goto program
+
+\*******************************************************************/
+
+void ssa_analyzert::get_dbm_row_bounds(
+  const local_SSAt &SSA,
+  tpolyhedra_domaint &tpolyhedra_domain,
+  std::map<tpolyhedra_domaint::rowt, mp_integer> &row_bounds)
+{
+  dbm_analysist dbm_analysis(SSA.goto_function, SSA.ns);
+
+  for(tpolyhedra_domaint::rowt row=0;
+      row<tpolyhedra_domain.template_size(); ++row)
+  {
+    mp_integer bound;
+    if(dbm_analysis.get_row_bound(
+         SSA, tpolyhedra_domain.get_template_row(row), bound))
+      row_bounds[row]=bound;
+  }
+
+  debug() << "DBM pre-analysis: bounds for " << row_bounds.size()
+          << " of " << tpolyhedra_domain.template_size() << " rows" << eom;
+}
+
+/*******************************************************************\
+
 Function: ssa_analyzert::operator()
 
   Inputs:
@@ -74,8 +174,40 @@ void ssa_analyzert::operator()(
   if(SSA.goto_function.body.instructions.empty())
     return;
 
-  solver << SSA;
-  SSA.mark_nodes();
+  if(template_generator.options.get_bool_option("cone-of-influence"))
+  {
+    // only the parts of the SSA that influence the template
+    exprt::operandst seeds;
+    seeds.push_back(precondition);
+    seeds.push_back(SSA.get_enabling_exprs());
+    for(const auto &v : template_generator.var_specs)
+    {
+      seeds.push_back(v.var);
+      seeds.push_back(v.pre_guard);
+      seeds.push_back(v.post_guard);
+      seeds.push_back(v.aux_expr);
+    }
+    for(const auto &m : template_generator.post_renaming_map)
+      seeds.push_back(m.second);
+    for(const auto &m : template_generator.init_renaming_map)
+      seeds.push_back(m.second);
+    for(const auto &m : template_generator.aux_renaming_map)
+      seeds.push_back(m.second);
+    for(const auto &g : SSA.loop_guards)
+    {
+      seeds.push_back(g.first);
+      seeds.push_back(g.second);
+    }
+
+    ssa_slicert ssa_slicer;
+    ssa_slicer.set_message_handler(get_message_handler());
+    ssa_slicer(solver, SSA, seeds);
+  }
+  else
+  {
+    solver << SSA;
+    SSA.mark_nodes();
+  }
 
   solver.new_context();
   solver << SSA.get_enabling_exprs();
@@ -134,6 +266,8 @@ void ssa_analyzert::operator()(
       get_message_handler(),
       template_generator);
     result=new heap_domaint::heap_valuet();
+    heap_domain=static_cast<heap_domaint *>(domain);
+    heap_value=static_cast<heap_domaint::heap_valuet *>(result);
   }
   else if(template_generator.options.get_bool_option("heap-interval")
           || template_generator.options.get_bool_option("heap-zones"))
@@ -159,7 +293,15 @@ void ssa_analyzert::operator()(
         precondition,
         get_message_handler(),
         template_generator);
-      result=new heap_tpolyhedra_domaint::heap_tpolyhedra_valuet();
+      heap_tpolyhedra_domaint::heap_tpolyhedra_valuet *value=
+        new heap_tpolyhedra_domaint::heap_tpolyhedra_valuet();
+      result=value;
+      heap_tpolyhedra_domaint *heap_tpolyhedra_domain=
+        static_cast<heap_tpolyhedra_domaint *>(domain);
+      heap_domain=&heap_tpolyhedra_domain->heap_domain;
+      heap_value=&value->heap_value;
+      tpolyhedra_domain=&heap_tpolyhedra_domain->polyhedra_domain;
+      tpolyhedra_value=&value->tpolyhedra_value;
     }
   }
   else
@@ -174,6 +316,8 @@ void ssa_analyzert::operator()(
         get_message_handler(),
         template_generator);
       result=new tpolyhedra_domaint::templ_valuet();
+      tpolyhedra_domain=static_cast<tpolyhedra_domaint *>(domain);
+      tpolyhedra_value=static_cast<tpolyhedra_domaint::templ_valuet *>(result);
     }
     else if(template_generator.options.get_bool_option("predabs-solver"))
     {
@@ -189,7 +333,23 @@ void ssa_analyzert::operator()(
     else if(template_generator.options.get_bool_option("binsearch-solver"))	
     {
       result=new tpolyhedra_domaint::templ_valuet();
-      s_solver=new BINSEARCH_SOLVER;
+      tpolyhedra_domain=static_cast<tpolyhedra_domaint *>(domain);
+      tpolyhedra_value=static_cast<tpolyhedra_domaint::templ_valuet *>(result);
+      strategy_solver_binsearcht *binsearch_solver=new BINSEARCH_SOLVER;
+      if(template_generator.options.get_bool_option("binsearch-gallop"))
+      {
+        std::set<mp_integer> thresholds;
+        collect_thresholds(SSA, thresholds);
+        binsearch_solver->set_thresholds(thresholds);
+      }
+      if(template_generator.options.get_bool_option("dbm-preanalysis"))
+      {
+        std::map<tpolyhedra_domaint::rowt, mp_integer> row_bounds;
+        get_dbm_row_bounds(
+          SSA, *static_cast<tpolyhedra_domaint *>(domain), row_bounds);
+        binsearch_solver->set_row_bounds(row_bounds);
+      }
+      s_solver=binsearch_solver;
     }
     else
       assert(false);
@@ -199,6 +359,8 @@ void ssa_analyzert::operator()(
 
   // initialize inv
   domain->initialize(*result);
+  if(warm_start!=NULL)
+    restore_fixpoint(*warm_start);
 
   // iterate
   while(s_solver->iterate(*result)) {}
@@ -209,6 +371,9 @@ void ssa_analyzert::operator()(
   solver_instances+=s_solver->get_number_of_solver_instances();
   solver_calls+=s_solver->get_number_of_solver_calls();
   solver_instances+=s_solver->get_number_of_solver_instances();
+  bound_search_calls+=s_solver->get_number_of_bound_search_calls();
+  bound_search_calls_baseline+=
+    s_solver->get_number_of_bound_search_calls_baseline();
 
   // imprecision identification 
   if(template_generator.options.get_bool_option("show-imprecise-vars"))
@@ -243,6 +408,133 @@ void ssa_analyzert::get_result(exprt &_result, const domaint::var_sett &vars)
 
 /*******************************************************************\
 
+Function: ssa_analyzert::restore_fixpoint
+
+  Inputs: fixpoint of a previous analysis
+
+ Outputs:
+
+ Purpose: the strategy iteration only stops at an inductive value,
+          hence starting from a previous fixpoint is sound; the first
+          iteration checks whether it is still a fixpoint
+
+\*******************************************************************/
+
+void ssa_analyzert::restore_fixpoint(const fixpointt &fixpoint)
+{
+  unsigned restored=0;
+  if(tpolyhedra_domain!=NULL)
+  {
+    restored+=tpolyhedra_domain->restore_value(
+      fixpoint.templ, fixpoint.templ_value, *tpolyhedra_value);
+  }
+  if(heap_domain!=NULL &&
+     fixpoint.heap_value &&
+     heap_domain->restore_value(
+       fixpoint.heap_templ, *fixpoint.heap_value, *heap_value))
+    restored+=heap_value->size();
+
+  debug() << "Warm start: " << restored << " template rows restored" << eom;
+}
+
+/*******************************************************************\
+
+Function: ssa_analyzert::get_fixpoint
+
+  Inputs:
+
+ Outputs: returns false if the domain does not support warm starts
+
+ Purpose:
+
+\*******************************************************************/
+
+bool ssa_analyzert::get_fixpoint(fixpointt &fixpoint) const
+{
+  if(tpolyhedra_domain==NULL && heap_domain==NULL)
+    return false;
+
+  if(tpolyhedra_domain!=NULL)
+  {
+    fixpoint.templ=tpolyhedra_domain->get_template();
+    fixpoint.templ_value=*tpolyhedra_value;
+  }
+  if(heap_domain!=NULL)
+  {
+    fixpoint.heap_templ=heap_domain->get_template();
+    fixpoint.heap_value=std::make_shared<heap_domaint::heap_valuet>();
+    for(std::size_t row=0; row<heap_value->size(); ++row)
+      fixpoint.heap_value->emplace_back((*heap_value)[row].clone());
+  }
+  return true;
+}
+
+/*******************************************************************\
+
+Function: ssa_analyzert::fixpointt::to_irep
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: converts the template polyhedra part of the fixpoint into
+          an irep for serialization
+
+\*******************************************************************/
+
+irept ssa_analyzert::fixpointt::to_irep() const
+{
+  assert(templ.size()==templ_value.size());
+  irept dest;
+  irept::subt &rows=dest.add("rows").get_sub();
+  for(std::size_t row=0; row<templ.size(); ++row)
+  {
+    irept r;
+    r.add("pre_guard")=templ[row].pre_guard;
+    r.add("post_guard")=templ[row].post_guard;
+    r.add(ID_expression)=templ[row].expr;
+    r.add("aux_expr")=templ[row].aux_expr;
+    r.set("kind", static_cast<long long>(templ[row].kind));
+    r.add(ID_value)=templ_value[row];
+    rows.push_back(r);
+  }
+  return dest;
+}
+
+/*******************************************************************\
+
+Function: ssa_analyzert::fixpointt::from_irep
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: restores the fixpoint from an irep created by to_irep
+
+\*******************************************************************/
+
+void ssa_analyzert::fixpointt::from_irep(const irept &irep)
+{
+  templ.clear();
+  templ_value.clear();
+  heap_templ.clear();
+  heap_value.reset();
+  for(const auto &r : irep.find("rows").get_sub())
+  {
+    tpolyhedra_domaint::template_rowt row;
+    row.pre_guard=static_cast<const exprt &>(r.find("pre_guard"));
+    row.post_guard=static_cast<const exprt &>(r.find("post_guard"));
+    row.expr=static_cast<const exprt &>(r.find(ID_expression));
+    row.aux_expr=static_cast<const exprt &>(r.find("aux_expr"));
+    row.kind=static_cast<domaint::kindt>(r.get_long_long("kind"));
+    templ.push_back(row);
+    templ_value.push_back(
+      to_constant_expr(static_cast<const exprt &>(r.find(ID_value))));
+  }
+}
+
+/*******************************************************************\
+
 Function: ssa_analyzert::update_heap_out
 
   Inputs:
@@ -9,13 +9,18 @@ Author: Peter Schrammel
 #ifndef CPROVER_2LS_DOMAINS_SSA_ANALYZER_H
 #define CPROVER_2LS_DOMAINS_SSA_ANALYZER_H
 
+#include <memory>
+
 #include <util/replace_expr.h>
+#include <util/mp_arith.h>
 
 #include <solver/summary.h>
 #include <ssa/local_ssa.h>
 
 #include "strategy_solver_base.h"
 #include "template_generator_base.h"
+#include "tpolyhedra_domain.h"
+#include "heap_domain.h"
 
 class ssa_analyzert:public messaget
 {
@@ -24,10 +29,32 @@ public:
   typedef strategy_solver_baset::var_listt var_listt;
   typedef summaryt::imprecise_varst imprecise_varst;
 
+  // the raw result of an analysis together with the templates
+  //  it refers to, used to warm-start another analysis
+  struct fixpointt
+  {
+    tpolyhedra_domaint::templatet templ;
+    tpolyhedra_domaint::templ_valuet templ_value;
+    heap_domaint::templatet heap_templ;
+    std::shared_ptr<heap_domaint::heap_valuet> heap_value;
+
+    // for sending fixpoints between processes,
+    //  the heap part is not serialized
+    irept to_irep() const;
+    void from_irep(const irept &irep);
+  };
+
   ssa_analyzert():
     result(NULL),
+    tpolyhedra_domain(NULL),
+    tpolyhedra_value(NULL),
+    heap_domain(NULL),
+    heap_value(NULL),
+    warm_start(NULL),
     solver_instances(0),
-    solver_calls(0)
+    solver_calls(0),
+    bound_search_calls(0),
+    bound_search_calls_baseline(0)
   {
   }
 
@@ -45,11 +72,25 @@ public:
 
   void get_result(exprt &result, const domaint::var_sett &vars);
 
+  // start the strategy iteration from the given fixpoint
+  //  instead of bottom, the fixpoint must outlive operator()
+  void set_warm_start(const fixpointt &fixpoint) { warm_start=&fixpoint; }
+  // returns false if the domain does not support warm starts
+  bool get_fixpoint(fixpointt &fixpoint) const;
+
   void update_heap_out(summaryt::var_sett &out);
   const exprt input_heap_bindings();
 
   inline unsigned get_number_of_solver_instances() { return solver_instances; }
   inline unsigned get_number_of_solver_calls() { return solver_calls; }
+  inline unsigned get_number_of_bound_search_calls()
+  {
+    return bound_search_calls;
+  }
+  inline unsigned get_number_of_bound_search_calls_baseline()
+  {
+    return bound_search_calls_baseline;
+  }
 
   void find_goto_instrs(
     local_SSAt &SSA, 
@@ -70,10 +111,30 @@ protected:
   domaint *domain; // template generator is responsible for the domain object
   domaint::valuet *result;
 
+  // the parts of the domain and of the result that can be warm-started
+  tpolyhedra_domaint *tpolyhedra_domain;
+  tpolyhedra_domaint::templ_valuet *tpolyhedra_value;
+  heap_domaint *heap_domain;
+  heap_domaint::heap_valuet *heap_value;
+  const fixpointt *warm_start;
+
+  void restore_fixpoint(const fixpointt &fixpoint);
+
   // statistics
   unsigned solver_instances;
   unsigned solver_calls;
+  unsigned bound_search_calls;
+  unsigned bound_search_calls_baseline;
   imprecise_varst vars_summary;
+
+  void collect_thresholds(
+    const local_SSAt &SSA,
+    std::set<mp_integer> &thresholds);
+
+  void get_dbm_row_bounds(
+    const local_SSAt &SSA,
+    tpolyhedra_domaint &tpolyhedra_domain,
+    std::map<tpolyhedra_domaint::rowt, mp_integer> &row_bounds);
 };
 
 #endif
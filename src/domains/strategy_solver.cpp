@@ -14,6 +14,7 @@ bool strategy_solvert::iterate(invariantt &inv)
 {
   bool improved=false;
 
+  solver_profilert::phaset profiler_phase("improvement");
   domain.solver_iter_init(inv);
   if(domain.has_something_to_solve())
   {
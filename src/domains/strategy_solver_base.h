@@ -27,13 +27,23 @@ class strategy_solver_baset:public messaget
     solver(_solver),
     ns(_ns),
     solver_instances(0),
-    solver_calls(0)
+    solver_calls(0),
+    bound_search_calls(0),
+    bound_search_calls_baseline(0)
   {}
 
   virtual bool iterate(invariantt &inv) { assert(false); }
 
   inline unsigned get_number_of_solver_calls() { return solver_calls; }
   inline unsigned get_number_of_solver_instances() { return solver_instances; }
+  inline unsigned get_number_of_bound_search_calls()
+  {
+    return bound_search_calls;
+  }
+  inline unsigned get_number_of_bound_search_calls_baseline()
+  {
+    return bound_search_calls_baseline;
+  }
 
   symbolic_patht symbolic_path;
 
@@ -49,6 +59,11 @@ class strategy_solver_baset:public messaget
   unsigned solver_instances;
   unsigned solver_calls;
 
+  // statistics for the search for optimal row values,
+  //  baseline is the number of calls of a plain bisection
+  unsigned bound_search_calls;
+  unsigned bound_search_calls_baseline;
+
   void find_symbolic_path(
     std::set<std::pair<symbol_exprt, symbol_exprt>> &loop_guards,
     const exprt &current_guard=nil_exprt());
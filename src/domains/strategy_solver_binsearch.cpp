@@ -10,6 +10,8 @@ Author: Peter Schrammel
 #include <iostream>
 #endif
 
+#include <util/arith_tools.h>
+
 #include "strategy_solver_binsearch.h"
 #include "util.h"
 
@@ -32,6 +34,7 @@ bool strategy_solver_binsearcht::iterate(invariantt &_inv)
 
   bool improved=false;
 
+  solver_profilert::phaset profiler_phase("improvement");
   solver.new_context(); // for improvement check
 
   exprt inv_expr=tpolyhedra_domain.to_pre_constraints(inv);
@@ -115,145 +118,385 @@ bool strategy_solver_binsearcht::iterate(invariantt &_inv)
 #endif
 
 
-    std::size_t row=0;
-    for(; row<tpolyhedra_domain.strategy_cond_literals.size(); row++)
+    // rows to improve with the lower bounds of their values
+    std::vector<std::pair<tpolyhedra_domaint::rowt,
+                          tpolyhedra_domaint::row_valuet> > improve_rows;
+    for(std::size_t row=0;
+        row<tpolyhedra_domain.strategy_cond_literals.size(); row++)
     {
       if(solver.l_get(tpolyhedra_domain.strategy_cond_literals[row]).is_true())
-        break;  // we've found a row to improve
+      {
+        improve_rows.push_back(
+          std::make_pair(
+            row,
+            simplify_const(
+              solver.get(tpolyhedra_domain.strategy_value_exprs[row]))));
+        if(!multi_row)
+          break;  // we've found a row to improve
+      }
     }
 
-    debug() << "improving row: " << row << eom;
-    std::set<tpolyhedra_domaint::rowt> improve_rows;
-    improve_rows.insert(row);
+    solver.pop_context();  // improvement check
 
-    tpolyhedra_domaint::row_valuet upper=
-      tpolyhedra_domain.get_max_row_value(row);
-    tpolyhedra_domaint::row_valuet lower=
-      simplify_const(solver.get(tpolyhedra_domain.strategy_value_exprs[row]));
+    if(multi_row)
+      debug() << "improving " << improve_rows.size()
+              << " row(s) at once" << eom;
 
-    solver.pop_context();  // improvement check
+    // The model values remain lower bounds for the rows when
+    //  other rows are improved before, since this only weakens
+    //  the pre-constraints.
+    for(const auto &r : improve_rows)
+    {
+      debug() << "improving row: " << r.first << eom;
+      improve_row(inv, r.first, r.second);
+    }
+    improved=true;
+  }
+  else
+  {
+#if 0
+    debug() << "UNSAT" << eom;
+#endif
+
+#ifdef DEBUG_FORMULA
+    for(std::size_t i=0; i<solver.formula.size(); ++i)
+    {
+      if(solver.solver->is_in_conflict(solver.formula[i]))
+        debug() << "is_in_conflict: " << solver.formula[i] << eom;
+      else
+        debug() << "not_in_conflict: " << solver.formula[i] << eom;
+    }
+#endif
+
+    solver.pop_context(); // improvement check
+  }
 
-    solver.new_context(); // symbolic value system
+  return improved;
+}
 
-    exprt pre_inv_expr=
-      tpolyhedra_domain.to_symb_pre_constraints(inv, improve_rows);
+/*******************************************************************\
 
-    solver << pre_inv_expr;
+Function: strategy_solver_binsearcht::improve_row
 
-    exprt post_inv_expr=tpolyhedra_domain.get_row_symb_post_constraint(row);
+  Inputs: invariant, row to improve, value of the row in the model
+          of the improvement check
 
-    solver << post_inv_expr;
+ Outputs:
+
+ Purpose: binary search for the maximal value of the row
+
+\*******************************************************************/
+
+void strategy_solver_binsearcht::improve_row(
+  tpolyhedra_domaint::templ_valuet &inv,
+  tpolyhedra_domaint::rowt row,
+  const tpolyhedra_domaint::row_valuet &model_value)
+{
+  std::set<tpolyhedra_domaint::rowt> improve_rows;
+  improve_rows.insert(row);
+
+  tpolyhedra_domaint::row_valuet upper=
+    tpolyhedra_domain.get_max_row_value(row);
+  tpolyhedra_domaint::row_valuet lower=model_value;
+
+  const typet type=lower.type();
+  bool bv_row=(type.id()==ID_signedbv || type.id()==ID_unsignedbv) &&
+    upper.type()==type;
+  unsigned calls_before=solver.get_number_of_solver_calls();
+
+  solver_profilert::phaset profiler_phase("binsearch");
+  solver.new_context(); // symbolic value system
+
+  exprt pre_inv_expr=
+    tpolyhedra_domain.to_symb_pre_constraints(inv, improve_rows);
+
+  solver << pre_inv_expr;
+
+  exprt post_inv_expr=tpolyhedra_domain.get_row_symb_post_constraint(row);
+
+  solver << post_inv_expr;
 
 #if 0
-    debug() << "symbolic value system: " << eom;
-    debug() << "pre-inv: " << from_expr(ns, "", pre_inv_expr) << eom;
-    debug() << "post-inv: " << from_expr(ns, "", post_inv_expr) << eom;
+  debug() << "symbolic value system: " << eom;
+  debug() << "pre-inv: " << from_expr(ns, "", pre_inv_expr) << eom;
+  debug() << "post-inv: " << from_expr(ns, "", post_inv_expr) << eom;
 #endif
 
-    while(tpolyhedra_domain.less_than(lower, upper))
+  // start with the bound from the pre-analysis if there is one
+  bool bounded=false;
+  tpolyhedra_domaint::row_valuet bound=upper;
+  std::map<tpolyhedra_domaint::rowt, mp_integer>::const_iterator b_it=
+    row_bounds.find(row);
+  if(bv_row && b_it!=row_bounds.end())
+  {
+    mp_integer vlower, vupper;
+    to_integer(to_constant_expr(lower), vlower);
+    to_integer(to_constant_expr(upper), vupper);
+    if(vlower<=b_it->second && b_it->second<vupper)
+    {
+      bound=from_integer(b_it->second, type);
+      upper=bound;
+      bounded=true;
+    }
+  }
+
+  if(gallop && bv_row)
+    gallop_search(row, lower, upper);
+
+  bisect(row, lower, upper);
+
+  // the bound from the pre-analysis is only a hint,
+  //  hence, we have to confirm it if it is reached
+  if(bounded && !tpolyhedra_domain.less_than(lower, bound))
+  {
+    mp_integer vbound;
+    to_integer(bound, vbound);
+    tpolyhedra_domaint::row_valuet max_value=
+      tpolyhedra_domain.get_max_row_value(row);
+    if(tpolyhedra_domain.less_than(bound, max_value))
     {
-      tpolyhedra_domaint::row_valuet middle=
-        tpolyhedra_domain.between(lower, upper);
-      if(!tpolyhedra_domain.less_than(lower, middle))
-        middle=upper;
+      // row_symb_value >= bound+1
+      exprt c=tpolyhedra_domain.get_row_symb_value_constraint(
+        row, from_integer(vbound+1, type), true);
+
+      solver.new_context(); // confirmation of bound
+      solver << c;
+      bool sat=solver()==decision_proceduret::D_SATISFIABLE;
+      if(sat)
+        lower=simplify_const(
+          solver.get(tpolyhedra_domain.get_row_symb_value(row)));
+      solver.pop_context(); // confirmation of bound
+
+      if(sat)
+      {
+        debug() << "bound from pre-analysis exceeded" << eom;
+        upper=max_value;
+        if(gallop)
+          gallop_search(row, lower, upper);
+        bisect(row, lower, upper);
+      }
+    }
+  }
+
+  if(message_enabled(*this, M_DEBUG))
+    debug() << "update value: " << from_expr(ns, "", lower) << eom;
+
+  solver.pop_context();  // symbolic value system
+
+  // statistics
+  unsigned calls=solver.get_number_of_solver_calls()-calls_before;
+  bound_search_calls+=calls;
+  // without galloping or a bound, this has been the plain binary search
+  if(bv_row && (gallop || bounded))
+  {
+    mp_integer vmodel, vmax, vresult;
+    to_integer(to_constant_expr(model_value), vmodel);
+    to_integer(
+      to_constant_expr(tpolyhedra_domain.get_max_row_value(row)), vmax);
+    to_integer(to_constant_expr(lower), vresult);
+    bound_search_calls_baseline+=bisection_calls(vmodel, vmax, vresult);
+  }
+  else
+    bound_search_calls_baseline+=calls;
+
+  tpolyhedra_domain.set_row_value(row, lower, inv);
+}
 
-      // row_symb_value >= middle
-      exprt c=
-        tpolyhedra_domain.get_row_symb_value_constraint(row, middle, true);
+/*******************************************************************\
+
+Function: strategy_solver_binsearcht::bisect
+
+  Inputs: row, value reached (lower), maximal possible value (upper)
+
+ Outputs: optimal value of the row in lower
+
+ Purpose: binary search in the symbolic value system
+
+\*******************************************************************/
+
+void strategy_solver_binsearcht::bisect(
+  tpolyhedra_domaint::rowt row,
+  tpolyhedra_domaint::row_valuet &lower,
+  tpolyhedra_domaint::row_valuet &upper)
+{
+  while(tpolyhedra_domain.less_than(lower, upper))
+  {
+    tpolyhedra_domaint::row_valuet middle=
+      tpolyhedra_domain.between(lower, upper);
+    if(!tpolyhedra_domain.less_than(lower, middle))
+      middle=upper;
+
+    // row_symb_value >= middle
+    exprt c=
+      tpolyhedra_domain.get_row_symb_value_constraint(row, middle, true);
 
 #if 0
-      debug() << "upper: " << from_expr(ns, "", upper) << eom;
-      debug() << "middle: " << from_expr(ns, "", middle) << eom;
-      debug() << "lower: " << from_expr(ns, "", lower) << eom;
+    debug() << "upper: " << from_expr(ns, "", upper) << eom;
+    debug() << "middle: " << from_expr(ns, "", middle) << eom;
+    debug() << "lower: " << from_expr(ns, "", lower) << eom;
 #endif
 
-      solver.new_context(); // binary search iteration
+    solver.new_context(); // binary search iteration
 
 #if 0
-      debug() << "constraint: " << from_expr(ns, "", c) << eom;
+    debug() << "constraint: " << from_expr(ns, "", c) << eom;
 #endif
 
-      solver << c;
+    solver << c;
 
-      if(solver()==decision_proceduret::D_SATISFIABLE)
-      {
+    if(solver()==decision_proceduret::D_SATISFIABLE)
+    {
 #if 0
-        debug() << "SAT" << eom;
+      debug() << "SAT" << eom;
 #endif
 
 #if 0
-        for(std::size_t i=0; i<tpolyhedra_domain.template_size(); i++)
-        {
-          debug() << from_expr(ns, "", tpolyhedra_domain.get_row_symb_value(i))
-                  << " " << from_expr(
-                    ns, "", solver.get(tpolyhedra_domain.get_row_symb_value(i)))
-                  << eom;
-        }
+      for(std::size_t i=0; i<tpolyhedra_domain.template_size(); i++)
+      {
+        debug() << from_expr(ns, "", tpolyhedra_domain.get_row_symb_value(i))
+                << " " << from_expr(
+                  ns, "", solver.get(tpolyhedra_domain.get_row_symb_value(i)))
+                << eom;
+      }
 #endif
 
 #if 0
-        for(const auto &rm : renaming_map)
-        {
-          debug() << "replace_map (1st): "
-                  << from_expr(ns, "", rm.first) << " "
-                  << from_expr(ns, "", solver.get(rm.first)) << eom;
-          debug() << "replace_map (2nd): "
-                  << from_expr(ns, "", rm.second) << " "
-                  << from_expr(ns, "", solver.get(rm.second)) << eom;
-        }
+      for(const auto &rm : renaming_map)
+      {
+        debug() << "replace_map (1st): "
+                << from_expr(ns, "", rm.first) << " "
+                << from_expr(ns, "", solver.get(rm.first)) << eom;
+        debug() << "replace_map (2nd): "
+                << from_expr(ns, "", rm.second) << " "
+                << from_expr(ns, "", solver.get(rm.second)) << eom;
+      }
 #endif
 
-        lower=simplify_const(
-          solver.get(tpolyhedra_domain.get_row_symb_value(row)));
-      }
-      else
-      {
+      lower=simplify_const(
+        solver.get(tpolyhedra_domain.get_row_symb_value(row)));
+    }
+    else
+    {
 #if 0
-        debug() << "UNSAT" << eom;
+      debug() << "UNSAT" << eom;
 #endif
 
 #if 0
-        for(std::size_t i=0; i<solver.formula.size(); ++i)
-        {
-          if(solver.solver->is_in_conflict(solver.formula[i]))
-            debug() << "is_in_conflict: " << solver.formula[i] << eom;
-          else
-            debug() << "not_in_conflict: " << solver.formula[i] << eom;
-        }
+      for(std::size_t i=0; i<solver.formula.size(); ++i)
+      {
+        if(solver.solver->is_in_conflict(solver.formula[i]))
+          debug() << "is_in_conflict: " << solver.formula[i] << eom;
+        else
+          debug() << "not_in_conflict: " << solver.formula[i] << eom;
+      }
 #endif
 
-        if(!tpolyhedra_domain.less_than(middle, upper))
-          middle=lower;
-        upper=middle;
-      }
-      solver.pop_context(); // binary search iteration
+      if(!tpolyhedra_domain.less_than(middle, upper))
+        middle=lower;
+      upper=middle;
     }
+    solver.pop_context(); // binary search iteration
+  }
 
-    debug() << "update value: " << from_expr(ns, "", lower) << eom;
+}
 
-    solver.pop_context();  // symbolic value system
+/*******************************************************************\
 
-    tpolyhedra_domain.set_row_value(row, lower, inv);
-    improved=true;
-  }
-  else
-  {
-#if 0
-    debug() << "UNSAT" << eom;
-#endif
+Function: strategy_solver_binsearcht::gallop_search
 
-#ifdef DEBUG_FORMULA
-    for(std::size_t i=0; i<solver.formula.size(); ++i)
+  Inputs: row, its value in the model of the improvement check,
+          the maximal value of the row
+
+ Outputs: narrowed interval for the binary search
+
+ Purpose: probes lower+1, lower+2, lower+4, ... until unsatisfiable;
+          program constants between lower and the next probe are
+          tried first
+
+\*******************************************************************/
+
+void strategy_solver_binsearcht::gallop_search(
+  tpolyhedra_domaint::rowt row,
+  tpolyhedra_domaint::row_valuet &lower,
+  tpolyhedra_domaint::row_valuet &upper)
+{
+  const typet type=lower.type();
+  mp_integer vupper;
+  to_integer(to_constant_expr(upper), vupper);
+
+  mp_integer step=1;
+  while(true)
+  {
+    mp_integer vlower;
+    to_integer(to_constant_expr(lower), vlower);
+
+    mp_integer probe=vlower+step;
+    std::set<mp_integer>::const_iterator t_it=thresholds.upper_bound(vlower);
+    bool is_threshold=t_it!=thresholds.end() && *t_it<probe;
+    if(is_threshold)
+      probe=*t_it;
+    if(probe>=vupper)
+      break; // remainder is left to the binary search
+
+    // row_symb_value >= probe
+    exprt c=tpolyhedra_domain.get_row_symb_value_constraint(
+      row, from_integer(probe, type), true);
+
+    solver.new_context(); // galloping iteration
+    solver << c;
+
+    bool sat=solver()==decision_proceduret::D_SATISFIABLE;
+    if(sat)
     {
-      if(solver.solver->is_in_conflict(solver.formula[i]))
-        debug() << "is_in_conflict: " << solver.formula[i] << eom;
-      else
-        debug() << "not_in_conflict: " << solver.formula[i] << eom;
+      lower=simplify_const(
+        solver.get(tpolyhedra_domain.get_row_symb_value(row)));
+      if(!is_threshold)
+        step*=2;
     }
-#endif
+    else
+      upper=from_integer(probe-1, type); // lower<probe
 
-    solver.pop_context(); // improvement check
+    solver.pop_context(); // galloping iteration
+
+    if(!sat)
+      break;
   }
+}
 
-  return improved;
+/*******************************************************************\
+
+Function: strategy_solver_binsearcht::bisection_calls
+
+  Inputs: row value in the model, maximal row value, optimal row value
+
+ Outputs: number of solver calls
+
+ Purpose: replays the plain binary search for the statistics
+          assuming the models yield the probed values
+
+\*******************************************************************/
+
+unsigned strategy_solver_binsearcht::bisection_calls(
+  const mp_integer &lower,
+  const mp_integer &upper,
+  const mp_integer &result)
+{
+  unsigned calls=0;
+  mp_integer l=lower, u=upper;
+  while(l<u)
+  {
+    mp_integer m=(l+1==u) ? l : (l+u)/2;
+    if(!(l<m))
+      m=u;
+    calls++;
+    if(m<=result)
+      l=m;
+    else
+    {
+      if(!(m<u))
+        m=l;
+      u=m;
+    }
+  }
+  return calls;
 }
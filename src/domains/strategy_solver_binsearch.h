@@ -9,6 +9,11 @@ Author: Peter Schrammel
 #ifndef CPROVER_2LS_DOMAINS_STRATEGY_SOLVER_BINSEARCH_H
 #define CPROVER_2LS_DOMAINS_STRATEGY_SOLVER_BINSEARCH_H
 
+#include <map>
+#include <set>
+
+#include <util/mp_arith.h>
+
 #include "strategy_solver_base.h"
 #include "tpolyhedra_domain.h"
 
@@ -18,16 +23,64 @@ public:
   strategy_solver_binsearcht(
     tpolyhedra_domaint &_tpolyhedra_domain,
     incremental_solvert &_solver,
-    const namespacet &_ns):
+    const namespacet &_ns,
+    bool _multi_row=false,
+    bool _gallop=false):
     strategy_solver_baset(_solver, _ns),
-    tpolyhedra_domain(_tpolyhedra_domain)
+    tpolyhedra_domain(_tpolyhedra_domain),
+    multi_row(_multi_row),
+    gallop(_gallop)
   {
   }
 
   virtual bool iterate(invariantt &inv);
 
+  // upper bounds for rows, e.g. from a pre-analysis,
+  //  they are confirmed by a solver call
+  void set_row_bounds(
+    const std::map<tpolyhedra_domaint::rowt, mp_integer> &_row_bounds)
+  {
+    row_bounds=_row_bounds;
+  }
+
+  // candidate bounds probed first by the galloping search
+  void set_thresholds(const std::set<mp_integer> &_thresholds)
+  {
+    thresholds=_thresholds;
+  }
+
 protected:
   tpolyhedra_domaint &tpolyhedra_domain;
+
+  // improve all rows that are improvable in the model
+  //  of a single improvement check
+  bool multi_row;
+
+  // exponential search upwards from the model value
+  //  before bisecting (bitvector rows only)
+  bool gallop;
+  std::set<mp_integer> thresholds;
+  std::map<tpolyhedra_domaint::rowt, mp_integer> row_bounds;
+
+  void bisect(
+    tpolyhedra_domaint::rowt row,
+    tpolyhedra_domaint::row_valuet &lower,
+    tpolyhedra_domaint::row_valuet &upper);
+
+  void gallop_search(
+    tpolyhedra_domaint::rowt row,
+    tpolyhedra_domaint::row_valuet &lower,
+    tpolyhedra_domaint::row_valuet &upper);
+
+  unsigned bisection_calls(
+    const mp_integer &lower,
+    const mp_integer &upper,
+    const mp_integer &result);
+
+  void improve_row(
+    tpolyhedra_domaint::templ_valuet &inv,
+    tpolyhedra_domaint::rowt row,
+    const tpolyhedra_domaint::row_valuet &model_value);
 };
 
 #endif
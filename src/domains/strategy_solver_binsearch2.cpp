@@ -39,6 +39,7 @@ bool strategy_solver_binsearch2t::iterate(invariantt &_inv)
 
   bool improved=false;
 
+  solver_profilert::phaset profiler_phase("improvement");
   solver.new_context(); // for improvement check
 
   exprt inv_expr=tpolyhedra_domain.to_pre_constraints(inv);
@@ -132,10 +133,11 @@ bool strategy_solver_binsearch2t::iterate(invariantt &_inv)
   std::map<tpolyhedra_domaint::rowt, symbol_exprt>::iterator
     it=symb_values.begin();
   exprt _lower=lower_values[it->first];
-#if 1
-  debug() << "update row " << it->first << ": "
-          << from_expr(ns, "", lower_values[it->first]) << eom;
-#endif
+  if(message_enabled(*this, M_DEBUG))
+  {
+    debug() << "update row " << it->first << ": "
+            << from_expr(ns, "", lower_values[it->first]) << eom;
+  }
   tpolyhedra_domain.set_row_value(it->first, lower_values[it->first], inv);
   exprt _upper=
     tpolyhedra_domain.get_max_row_value(it->first);
@@ -146,10 +148,11 @@ bool strategy_solver_binsearch2t::iterate(invariantt &_inv)
     _upper=plus_exprt(_upper, tpolyhedra_domain.get_max_row_value(it->first));
     _lower=plus_exprt(_lower, lower_values[it->first]);
 
-#if 1
-    debug() << "update row " << it->first << ": "
-            << from_expr(ns, "", lower_values[it->first]) << eom;
-#endif
+    if(message_enabled(*this, M_DEBUG))
+    {
+      debug() << "update row " << it->first << ": "
+              << from_expr(ns, "", lower_values[it->first]) << eom;
+    }
     tpolyhedra_domain.set_row_value(it->first, lower_values[it->first], inv);
   }
 
@@ -158,6 +161,7 @@ bool strategy_solver_binsearch2t::iterate(invariantt &_inv)
   if(improved_from_neginf)
     return improved;
 
+  solver_profilert::phaset profiler_binsearch_phase("binsearch");
   solver.new_context(); // symbolic value system
   solver << pre_inv_expr;
   solver << post_inv_expr;
@@ -214,15 +218,17 @@ bool strategy_solver_binsearch2t::iterate(invariantt &_inv)
 
       for(const auto &sv : symb_values)
       {
-#if 1
-        debug() << "update row " << sv.first << " "
-                << from_expr(ns, "", sv.second) << ": ";
-#endif
+        if(message_enabled(*this, M_DEBUG))
+        {
+          debug() << "update row " << sv.first << " "
+                  << from_expr(ns, "", sv.second) << ": ";
+        }
         constant_exprt lower_row=
           simplify_const(solver.get(sv.second));
-#if 1
-        debug() << from_expr(ns, "", lower_row) << eom;
-#endif
+        if(message_enabled(*this, M_DEBUG))
+        {
+          debug() << from_expr(ns, "", lower_row) << eom;
+        }
         tpolyhedra_domain.set_row_value(sv.first, lower_row, inv);
       }
     }
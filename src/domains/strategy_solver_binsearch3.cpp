@@ -38,6 +38,7 @@ bool strategy_solver_binsearch3t::iterate(invariantt &_inv)
 
   bool improved=false;
 
+  solver_profilert::phaset profiler_phase("improvement");
   solver.new_context(); // for improvement check
 
   exprt inv_expr=tpolyhedra_domain.to_pre_constraints(inv);
@@ -129,10 +130,11 @@ bool strategy_solver_binsearch3t::iterate(invariantt &_inv)
   std::map<tpolyhedra_domaint::rowt, symbol_exprt>::iterator
     it=symb_values.begin();
   exprt _lower=lower_values[it->first];
-#if 1
-  debug() << "update row " << it->first << ": "
-          << from_expr(ns, "", lower_values[it->first]) << eom;
-#endif
+  if(message_enabled(*this, M_DEBUG))
+  {
+    debug() << "update row " << it->first << ": "
+            << from_expr(ns, "", lower_values[it->first]) << eom;
+  }
   tpolyhedra_domain.set_row_value(it->first, lower_values[it->first], inv);
   exprt _upper=
     tpolyhedra_domain.get_max_row_value(it->first);
@@ -143,10 +145,11 @@ bool strategy_solver_binsearch3t::iterate(invariantt &_inv)
     _upper=plus_exprt(_upper, tpolyhedra_domain.get_max_row_value(it->first));
     _lower=plus_exprt(_lower, lower_values[it->first]);
 
-#if 1
-    debug() << "update row " << it->first << ": "
-            << from_expr(ns, "", lower_values[it->first]) << eom;
-#endif
+    if(message_enabled(*this, M_DEBUG))
+    {
+      debug() << "update row " << it->first << ": "
+              << from_expr(ns, "", lower_values[it->first]) << eom;
+    }
     tpolyhedra_domain.set_row_value(it->first, lower_values[it->first], inv);
   }
 
@@ -155,15 +158,17 @@ bool strategy_solver_binsearch3t::iterate(invariantt &_inv)
   if(improved_from_neginf)
     return improved;
 
+  solver_profilert::phaset profiler_binsearch_phase("binsearch");
   solver.new_context(); // symbolic value system
   solver << pre_inv_expr;
   solver << post_inv_expr;
 
-#if 1
-  debug() << "symbolic value system: " << eom;
-  debug() << "pre-inv: " << from_expr(ns, "", pre_inv_expr) << eom;
-  debug() << "post-inv: " << from_expr(ns, "", post_inv_expr) << eom;
-#endif
+  if(message_enabled(*this, M_DEBUG))
+  {
+    debug() << "symbolic value system: " << eom;
+    debug() << "pre-inv: " << from_expr(ns, "", pre_inv_expr) << eom;
+    debug() << "post-inv: " << from_expr(ns, "", post_inv_expr) << eom;
+  }
 
   extend_expr_types(sum);
   extend_expr_types(_upper);
@@ -178,9 +183,10 @@ bool strategy_solver_binsearch3t::iterate(invariantt &_inv)
     sum.type());
   solver << equal_exprt(sum_bound, sum);
 
-#if 1
-  debug() << from_expr(ns, "", equal_exprt(sum_bound, sum)) << eom;
-#endif
+  if(message_enabled(*this, M_DEBUG))
+  {
+    debug() << from_expr(ns, "", equal_exprt(sum_bound, sum)) << eom;
+  }
 
   while(tpolyhedra_domain.less_than(lower, upper))
   {
@@ -193,17 +199,19 @@ bool strategy_solver_binsearch3t::iterate(invariantt &_inv)
     assert(sum_bound.type()==middle.type());
     exprt c=binary_relation_exprt(sum_bound, ID_ge, middle);
 
-#if 1
-    debug() << "upper: " << from_expr(ns, "", upper) << eom;
-    debug() << "middle: " << from_expr(ns, "", middle) << eom;
-    debug() << "lower: " << from_expr(ns, "", lower) << eom;
-#endif
+    if(message_enabled(*this, M_DEBUG))
+    {
+      debug() << "upper: " << from_expr(ns, "", upper) << eom;
+      debug() << "middle: " << from_expr(ns, "", middle) << eom;
+      debug() << "lower: " << from_expr(ns, "", lower) << eom;
+    }
 
     solver.new_context(); // binary search iteration
 
-#if 1
-    debug() << "constraint: " << from_expr(ns, "", c) << eom;
-#endif
+    if(message_enabled(*this, M_DEBUG))
+    {
+      debug() << "constraint: " << from_expr(ns, "", c) << eom;
+    }
 
     solver << c;
 
@@ -217,15 +225,17 @@ bool strategy_solver_binsearch3t::iterate(invariantt &_inv)
 
       for(const auto &sv : symb_values)
       {
-#if 1
-        debug() << "update row " << sv.first << " "
-                << from_expr(ns, "", sv.second) << ": ";
-#endif
+        if(message_enabled(*this, M_DEBUG))
+        {
+          debug() << "update row " << sv.first << " "
+                  << from_expr(ns, "", sv.second) << ": ";
+        }
         constant_exprt lower_row=
           simplify_const(solver.get(sv.second));
-#if 1
-        debug() << from_expr(ns, "", lower_row) << eom;
-#endif
+        if(message_enabled(*this, M_DEBUG))
+        {
+          debug() << from_expr(ns, "", lower_row) << eom;
+        }
         tpolyhedra_domain.set_row_value(sv.first, lower_row, inv);
       }
     }
@@ -157,6 +157,7 @@ bool strategy_solver_heap_tpolyhedra_sympatht::is_current_path_feasible(
 {
   bool result=true;
   auto sympath=symbolic_path.get_expr();
+  solver_profilert::phaset profiler_phase("path-feasibility");
   solver.new_context();
 
   // Path invariant
@@ -726,6 +726,409 @@ bool template_generator_baset::instantiate_custom_templates(
 
 /*******************************************************************\
 
+Function: is_guard_symbol
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static bool is_guard_symbol(const irep_idt &identifier)
+{
+  const std::string &id=id2string(identifier);
+  return has_prefix(id, "ssa::$guard") || has_prefix(id, "ssa::$cond");
+}
+
+/*******************************************************************\
+
+Function: add_interaction_vertices
+
+  Inputs: symbols of an expression, the variables that the guards
+          and conditions depend on
+
+ Outputs: the vertices of the symbols are added to dest
+
+ Purpose: the SSA instances of a program variable share a vertex;
+          guards and conditions are not vertices, they stand for
+          the variables that they depend on
+
+\*******************************************************************/
+
+static void add_interaction_vertices(
+  const find_symbols_sett &symbols,
+  const std::map<irep_idt, std::set<irep_idt> > &control_vars,
+  std::set<irep_idt> &dest)
+{
+  for(const auto &s : symbols)
+  {
+    if(!is_guard_symbol(s))
+    {
+      dest.insert(get_original_name(symbol_exprt(s)));
+      continue;
+    }
+    std::map<irep_idt, std::set<irep_idt> >::const_iterator c_it=
+      control_vars.find(s);
+    if(c_it!=control_vars.end())
+      dest.insert(c_it->second.begin(), c_it->second.end());
+  }
+}
+
+/*******************************************************************\
+
+Function: template_generator_baset::get_related_vars
+
+  Inputs:
+
+ Outputs: the pairs of variables in var_specs that interact,
+          NULL if all pairs shall be related
+
+ Purpose: Builds a graph over the variables in the loop bodies:
+          the left-hand side of an equality is adjacent to the
+          variables on its right-hand side, and the variables of a
+          constraint are adjacent to each other. A guard only adds
+          the control dependency on the conditions in its own
+          definition; in particular, the loop-select and loop-head
+          guards, which all phis of a loop share, do not relate
+          the variables of the loop. Loop variables are related if
+          they are connected by a path with at most the number of
+          edges given by --sparse-templates. Variables that are not
+          loop variables are related to all others.
+
+\*******************************************************************/
+
+const domaint::var_pairst *template_generator_baset::get_related_vars(
+  const local_SSAt &SSA)
+{
+  if(options.get_option("sparse-templates")=="")
+    return NULL;
+  unsigned distance=options.get_unsigned_int_option("sparse-templates");
+
+  // the nodes of the loop bodies, the body of a loop is between
+  //  its head and its back edge
+  std::vector<const local_SSAt::nodet *> body;
+  std::set<const local_SSAt::nodet *> visited;
+  for(local_SSAt::nodest::const_iterator n_it=SSA.nodes.begin();
+      n_it!=SSA.nodes.end(); n_it++)
+  {
+    if(n_it->loophead==SSA.nodes.end())
+      continue;
+    local_SSAt::nodest::const_iterator b_it=n_it->loophead;
+    for(bool last=false; !last; b_it++)
+    {
+      last=(b_it==n_it);
+      if(visited.insert(&(*b_it)).second)
+        body.push_back(&(*b_it));
+    }
+  }
+
+  // the variables of the conditions, then those of the conditions
+  //  in the definitions of the guards; loop-select guards are free
+  std::map<irep_idt, std::set<irep_idt> > control_vars;
+  for(const char *prefix : {"ssa::$cond", "ssa::$guard"})
+  {
+    for(const auto &node : body)
+    {
+      for(const auto &e : node->equalities)
+      {
+        if(e.lhs().id()!=ID_symbol)
+          continue;
+        const irep_idt &lhs=to_symbol_expr(e.lhs()).get_identifier();
+        if(!has_prefix(id2string(lhs), prefix))
+          continue;
+        find_symbols_sett symbols;
+        find_symbols(e.rhs(), symbols);
+        // guards are not followed transitively
+        find_symbols_sett conds;
+        for(const auto &sym : symbols)
+          if(!has_prefix(id2string(sym), "ssa::$guard"))
+            conds.insert(sym);
+        std::set<irep_idt> vars;
+        add_interaction_vertices(conds, control_vars, vars);
+        control_vars[lhs].insert(vars.begin(), vars.end());
+      }
+    }
+  }
+
+  typedef std::map<irep_idt, std::set<irep_idt> > grapht;
+  grapht graph;
+  for(const auto &node : body)
+  {
+    for(const auto &e : node->equalities)
+    {
+      if(e.lhs().id()!=ID_symbol ||
+         is_guard_symbol(to_symbol_expr(e.lhs()).get_identifier()))
+        continue;
+      irep_idt lhs=get_original_name(to_symbol_expr(e.lhs()));
+      find_symbols_sett symbols;
+      find_symbols(e.rhs(), symbols);
+      std::set<irep_idt> vertices;
+      add_interaction_vertices(symbols, control_vars, vertices);
+      for(const auto &v : vertices)
+      {
+        graph[lhs].insert(v);
+        graph[v].insert(lhs);
+      }
+    }
+    for(const auto &c : node->constraints)
+    {
+      find_symbols_sett symbols;
+      find_symbols(c, symbols);
+      std::set<irep_idt> vertices;
+      add_interaction_vertices(symbols, control_vars, vertices);
+      for(const auto &v : vertices)
+        graph[v].insert(vertices.begin(), vertices.end());
+    }
+  }
+
+  // the vertices of the loop variables
+  std::vector<irep_idt> vertices(var_specs.size());
+  for(std::size_t i=0; i<var_specs.size(); ++i)
+  {
+    if(var_specs[i].kind==domaint::LOOP && var_specs[i].var.id()==ID_symbol)
+      vertices[i]=get_original_name(to_symbol_expr(var_specs[i].var));
+  }
+
+  related_vars.clear();
+  std::map<irep_idt, std::set<irep_idt> > reachable;
+  for(std::size_t i=0; i<var_specs.size(); ++i)
+  {
+    std::set<irep_idt> *reached=NULL;
+    if(!vertices[i].empty())
+    {
+      reached=&reachable[vertices[i]];
+      if(reached->empty())
+      {
+        // breadth-first search up to the given distance
+        reached->insert(vertices[i]);
+        std::vector<irep_idt> frontier(1, vertices[i]);
+        for(unsigned d=0; d<distance && !frontier.empty(); d++)
+        {
+          std::vector<irep_idt> next;
+          for(const auto &v : frontier)
+          {
+            grapht::const_iterator g_it=graph.find(v);
+            if(g_it==graph.end())
+              continue;
+            for(const auto &w : g_it->second)
+              if(reached->insert(w).second)
+                next.push_back(w);
+          }
+          frontier.swap(next);
+        }
+      }
+    }
+
+    for(std::size_t j=i+1; j<var_specs.size(); ++j)
+    {
+      if(reached==NULL || vertices[j].empty() ||
+         reached->find(vertices[j])!=reached->end())
+        related_vars.insert(std::make_pair(i, j));
+    }
+  }
+
+  std::size_t n=var_specs.size();
+  std::size_t pairs=(n*(n-1))/2;
+  debug() << "Sparse templates: " << related_vars.size() << " of "
+          << pairs << " pairs of variables related ("
+          << pairs-related_vars.size() << " dropped)" << eom;
+
+  return &related_vars;
+}
+
+/*******************************************************************\
+
+Function: template_generator_baset::get_independent_loops
+
+  Inputs:
+
+ Outputs: groups of loop variables, empty if the loops cannot be
+          analyzed separately
+
+ Purpose: The invariant of a loop depends on another loop if the
+          values that it reads, including its guards and the
+          conditions of its branches and phis, are computed from
+          the loop-back variables of the other loop. Hence, a loop
+          after another loop is dependent unless the exit condition
+          of the other loop is independent of its loop-back
+          variables, and the loops of a group have the same
+          invariant as in a single domain. Nested loops are always
+          dependent, as the inner loop is part of the body of the
+          outer loop. The input variables are added to every group.
+          Only the template polyhedra domains are split as only
+          they give the fixpoints that the groups are combined
+          from.
+
+\*******************************************************************/
+
+void template_generator_baset::get_independent_loops(
+  const local_SSAt &SSA,
+  std::vector<domaint::var_specst> &loop_groups)
+{
+  loop_groups.clear();
+  if(!standard_domains ||
+     options.get_bool_option("equalities") ||
+     options.get_bool_option("heap") ||
+     options.get_bool_option("heap-interval") ||
+     options.get_bool_option("heap-zones") ||
+     options.get_bool_option("compute-ranking-functions") ||
+     !(options.get_bool_option("enum-solver") ||
+       options.get_bool_option("binsearch-solver")) ||
+     !(options.get_bool_option("intervals") ||
+       options.get_bool_option("zones") ||
+       options.get_bool_option("octagons") ||
+       options.get_bool_option("qzones")))
+    return;
+
+  // the loops by their back edges
+  std::vector<local_SSAt::nodest::const_iterator> loops;
+  std::vector<exprt> loop_pre_guards;
+  for(local_SSAt::nodest::const_iterator n_it=SSA.nodes.begin();
+      n_it!=SSA.nodes.end(); n_it++)
+  {
+    if(n_it->loophead==SSA.nodes.end())
+      continue;
+    exprt pre_guard, post_guard;
+    get_pre_post_guards(SSA, n_it, pre_guard, post_guard);
+    loops.push_back(n_it);
+    loop_pre_guards.push_back(pre_guard);
+  }
+  if(loops.size()<2)
+    return;
+
+  // the loop variables of each loop
+  std::vector<std::vector<std::size_t> > loop_var_specs(loops.size());
+  std::vector<std::set<irep_idt> > loop_vars(loops.size());
+  domaint::var_specst in_var_specs;
+  for(std::size_t i=0; i<var_specs.size(); ++i)
+  {
+    if(var_specs[i].kind==domaint::IN)
+      in_var_specs.push_back(var_specs[i]);
+    if(var_specs[i].kind!=domaint::LOOP)
+      continue;
+    std::size_t l=0;
+    while(l<loops.size() && loop_pre_guards[l]!=var_specs[i].pre_guard)
+      l++;
+    if(l==loops.size() || var_specs[i].var.id()!=ID_symbol)
+      return;
+    loop_var_specs[l].push_back(i);
+    loop_vars[l].insert(to_symbol_expr(var_specs[i].var).get_identifier());
+  }
+
+  // the symbols on which the equalities depend
+  std::map<irep_idt, find_symbols_sett> defs;
+  for(const auto &node : SSA.nodes)
+  {
+    for(const auto &e : node.equalities)
+    {
+      if(e.lhs().id()==ID_symbol)
+        find_symbols(
+          e.rhs(), defs[to_symbol_expr(e.lhs()).get_identifier()]);
+    }
+  }
+
+  // the loop bodies and the symbols that the loops depend on
+  std::vector<std::set<const local_SSAt::nodet *> > bodies(loops.size());
+  std::vector<std::set<irep_idt> > depends_on(loops.size());
+  for(std::size_t l=0; l<loops.size(); ++l)
+  {
+    find_symbols_sett reads;
+    local_SSAt::nodest::const_iterator b_it=loops[l]->loophead;
+    for(bool last=false; !last; b_it++)
+    {
+      last=(b_it==loops[l]);
+      bodies[l].insert(&(*b_it));
+      for(const auto &e : b_it->equalities)
+        find_symbols(e.rhs(), reads);
+      for(const auto &c : b_it->constraints)
+        find_symbols(c, reads);
+    }
+
+    std::vector<irep_idt> worklist(reads.begin(), reads.end());
+    while(!worklist.empty())
+    {
+      irep_idt id=worklist.back();
+      worklist.pop_back();
+      if(!depends_on[l].insert(id).second)
+        continue;
+      std::map<irep_idt, find_symbols_sett>::const_iterator d_it=
+        defs.find(id);
+      if(d_it!=defs.end())
+        worklist.insert(
+          worklist.end(), d_it->second.begin(), d_it->second.end());
+    }
+  }
+
+  // loops are in the same group if one of them depends on the other
+  std::vector<std::size_t> group(loops.size());
+  for(std::size_t l=0; l<loops.size(); ++l)
+  {
+    group[l]=l;
+    for(std::size_t other=0; other<l; ++other)
+    {
+      bool dependent=false;
+      for(const auto &node : bodies[l])
+        dependent=dependent || bodies[other].find(node)!=bodies[other].end();
+      for(const auto &v : loop_vars[other])
+        dependent=dependent || depends_on[l].find(v)!=depends_on[l].end();
+      for(const auto &v : loop_vars[l])
+        dependent=dependent ||
+          depends_on[other].find(v)!=depends_on[other].end();
+
+      if(dependent && group[other]!=group[l])
+      {
+        std::size_t old_group=group[l];
+        for(auto &g : group)
+          if(g==old_group)
+            g=group[other];
+      }
+    }
+  }
+
+  std::map<std::size_t, domaint::var_specst> groups;
+  for(std::size_t l=0; l<loops.size(); ++l)
+  {
+    for(const auto &i : loop_var_specs[l])
+      groups[group[l]].push_back(var_specs[i]);
+  }
+  if(groups.size()<2)
+    return;
+
+  for(const auto &g : groups)
+  {
+    loop_groups.push_back(in_var_specs);
+    loop_groups.back().insert(
+      loop_groups.back().end(), g.second.begin(), g.second.end());
+  }
+}
+
+/*******************************************************************\
+
+Function: template_generator_baset::restrict_template
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void template_generator_baset::restrict_template(
+  const local_SSAt &SSA,
+  const domaint::var_specst &vars)
+{
+  assert(standard_domains);
+  delete domain_ptr;
+  domain_ptr=NULL;
+  var_specs=vars;
+  instantiate_standard_domains(SSA);
+}
+
+/*******************************************************************\
+
 Function: template_generator_baset::instantiate_standard_domains
 
   Inputs:
@@ -741,6 +1144,7 @@ void template_generator_baset::instantiate_standard_domains(
 {
   replace_mapt &renaming_map=
     std_invariants ? aux_renaming_map : post_renaming_map;
+  standard_domains=true;
 
   // get domain from command line options
   if(options.get_bool_option("equalities"))
@@ -767,8 +1171,9 @@ void template_generator_baset::instantiate_standard_domains(
     domain_ptr=
       new tpolyhedra_domaint(domain_number, renaming_map, SSA.ns);
     filter_template_domain();
+    const domaint::var_pairst *related=get_related_vars(SSA);
     static_cast<tpolyhedra_domaint *>(domain_ptr)
-      ->add_difference_template(var_specs, SSA.ns);
+      ->add_difference_template(var_specs, SSA.ns, related);
     static_cast<tpolyhedra_domaint *>(domain_ptr)
       ->add_interval_template(var_specs, SSA.ns);
   }
@@ -777,10 +1182,11 @@ void template_generator_baset::instantiate_standard_domains(
     domain_ptr=
       new tpolyhedra_domaint(domain_number, renaming_map, SSA.ns);
     filter_template_domain();
+    const domaint::var_pairst *related=get_related_vars(SSA);
     static_cast<tpolyhedra_domaint *>(domain_ptr)
-      ->add_sum_template(var_specs, SSA.ns);
+      ->add_sum_template(var_specs, SSA.ns, related);
     static_cast<tpolyhedra_domaint *>(domain_ptr)
-      ->add_difference_template(var_specs, SSA.ns);
+      ->add_difference_template(var_specs, SSA.ns, related);
     static_cast<tpolyhedra_domaint *>(domain_ptr)
       ->add_interval_template(var_specs, SSA.ns);
   }
@@ -789,8 +1195,9 @@ void template_generator_baset::instantiate_standard_domains(
     domain_ptr=
       new tpolyhedra_domaint(domain_number, renaming_map, SSA.ns);
     filter_template_domain();
+    const domaint::var_pairst *related=get_related_vars(SSA);
     static_cast<tpolyhedra_domaint *>(domain_ptr)
-      ->add_difference_template(var_specs, SSA.ns);
+      ->add_difference_template(var_specs, SSA.ns, related);
     static_cast<tpolyhedra_domaint *>(domain_ptr)
       ->add_quadratic_template(var_specs, SSA.ns);
   }
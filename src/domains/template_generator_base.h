@@ -32,6 +32,7 @@ public:
     ssa_local_unwinder(_ssa_local_unwinder)
   {
     std_invariants=options.get_bool_option("std-invariants");
+    standard_domains=false;
   }
 
   virtual ~template_generator_baset()
@@ -53,6 +54,17 @@ public:
 
   inline domaint *domain() { assert(domain_ptr!=NULL); return domain_ptr; }
 
+  // partitions the loop variables in var_specs into groups of loops
+  //  whose invariants do not depend on each other, each group also
+  //  contains the input variables
+  void get_independent_loops(
+    const local_SSAt &SSA,
+    std::vector<domaint::var_specst> &loop_groups);
+  // rebuilds the domain for the given variables only
+  void restrict_template(
+    const local_SSAt &SSA,
+    const domaint::var_specst &vars);
+
   domaint::var_specst var_specs;
   replace_mapt post_renaming_map;
   replace_mapt init_renaming_map;
@@ -66,6 +78,7 @@ protected:
   const ssa_local_unwindert &ssa_local_unwinder;
   domaint *domain_ptr;
   bool std_invariants; // include value at loop entry
+  bool standard_domains; // no custom templates
 
   virtual void collect_variables_loop(
     const local_SSAt &SSA,
@@ -76,6 +89,9 @@ protected:
     local_SSAt::nodest::const_iterator loop_begin,
     local_SSAt::nodest::const_iterator loop_end);
 
+  // for sparse templates, see get_related_vars
+  domaint::var_pairst related_vars;
+
   void filter_template_domain();
   void filter_equality_domain();
   void filter_heap_domain();
@@ -129,6 +145,8 @@ protected:
     local_SSAt::nodest::const_iterator n_it,
     exprt &expr);
 
+  const domaint::var_pairst *get_related_vars(const local_SSAt &SSA);
+
   virtual void handle_special_functions(const local_SSAt &SSA);
   void instantiate_standard_domains(const local_SSAt &SSA);
   bool instantiate_custom_templates(const local_SSAt &SSA);
@@ -13,6 +13,7 @@ Author: Peter Schrammel
 #include "template_generator_callingcontext.h"
 #include "equality_domain.h"
 #include "tpolyhedra_domain.h"
+#include "util.h"
 
 /*******************************************************************\
 
@@ -42,12 +43,13 @@ void template_generator_callingcontextt::operator()(
   // get domain from command line options
   instantiate_standard_domains(SSA);
 
-#if 1
-  debug() << "Template variables: " << eom;
-  domaint::output_var_specs(debug(), var_specs, SSA.ns); debug() << eom;
-  debug() << "Template: " << eom;
-  domain_ptr->output_domain(debug(), SSA.ns); debug() << eom;
-#endif
+  if(message_enabled(*this, M_DEBUG))
+  {
+    debug() << "Template variables: " << eom;
+    domaint::output_var_specs(debug(), var_specs, SSA.ns); debug() << eom;
+    debug() << "Template: " << eom;
+    domain_ptr->output_domain(debug(), SSA.ns); debug() << eom;
+  }
 }
 
 /*******************************************************************\
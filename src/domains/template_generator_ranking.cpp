@@ -9,6 +9,7 @@ Author: Peter Schrammel
 #include "template_generator_ranking.h"
 #include "linrank_domain.h"
 #include "lexlinrank_domain.h"
+#include "util.h"
 
 #include <util/find_symbols.h>
 #include <util/arith_tools.h>
@@ -62,12 +63,13 @@ void template_generator_rankingt::operator()(
 
   options.set_option("compute-ranking-functions", true);
 
-#if 1
-  debug() << "Template variables: " << eom;
-  domaint::output_var_specs(debug(), var_specs, SSA.ns); debug() << eom;
-  debug() << "Template: " << eom;
-  domain_ptr->output_domain(debug(), SSA.ns); debug() << eom;
-#endif
+  if(message_enabled(*this, M_DEBUG))
+  {
+    debug() << "Template variables: " << eom;
+    domaint::output_var_specs(debug(), var_specs, SSA.ns); debug() << eom;
+    debug() << "Template: " << eom;
+    domain_ptr->output_domain(debug(), SSA.ns); debug() << eom;
+  }
 }
 
 /*******************************************************************\
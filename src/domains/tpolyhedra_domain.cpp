@@ -11,6 +11,8 @@ Author: Peter Schrammel
 #include <langapi/languages.h>
 #endif
 
+#include <cctype>
+
 #include <util/find_symbols.h>
 #include <util/i2string.h>
 #include <util/simplify_expr.h>
@@ -887,6 +889,107 @@ void tpolyhedra_domaint::output_domain(
   }
 }
 
+/*******************************************************************\
+
+Function: remove_unwinding_suffixes
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: removes the unwinding suffixes, e.g. %1%2, from the
+          identifiers of the symbols in the expression
+
+\*******************************************************************/
+
+static void remove_unwinding_suffixes(exprt &expr)
+{
+  if(expr.id()==ID_symbol)
+  {
+    const std::string &id=id2string(to_symbol_expr(expr).get_identifier());
+    std::size_t pos=id.find('%');
+    if(pos==std::string::npos)
+      return;
+    std::size_t end=pos;
+    while(end<id.size() && (id[end]=='%' || isdigit(id[end])))
+      ++end;
+    to_symbol_expr(expr).set_identifier(id.substr(0, pos)+id.substr(end));
+    return;
+  }
+  Forall_operands(it, expr)
+    remove_unwinding_suffixes(*it);
+}
+
+/*******************************************************************\
+
+Function: tpolyhedra_domaint::restore_value
+
+  Inputs: template and value of a previous analysis
+
+ Outputs: number of rows whose value has been taken
+
+ Purpose: any value is a sound starting point for the strategy
+          iteration, hence the rows need not match exactly;
+          after further unwinding, the rows refer to the variables
+          of the last unwinding, hence the rows are matched without
+          the unwinding suffixes of their symbols
+
+\*******************************************************************/
+
+unsigned tpolyhedra_domaint::restore_value(
+  const templatet &old_templ,
+  const templ_valuet &old_value,
+  templ_valuet &value) const
+{
+  assert(old_templ.size()==old_value.size());
+  assert(value.size()==templ.size());
+
+  // the rows without suffixes with their index in the old template
+  typedef std::vector<std::pair<rowt, template_rowt> > rowst;
+  typedef std::map<exprt, rowst> row_mapt;
+  row_mapt old_rows;
+  for(rowt row=0; row<old_templ.size(); ++row)
+  {
+    template_rowt old_row=old_templ[row];
+    remove_unwinding_suffixes(old_row.expr);
+    remove_unwinding_suffixes(old_row.pre_guard);
+    remove_unwinding_suffixes(old_row.post_guard);
+    remove_unwinding_suffixes(old_row.aux_expr);
+    old_rows[old_row.expr].push_back(std::make_pair(row, old_row));
+  }
+
+  unsigned restored=0;
+  for(rowt row=0; row<templ.size(); ++row)
+  {
+    exprt expr=templ[row].expr;
+    remove_unwinding_suffixes(expr);
+    row_mapt::const_iterator r_it=old_rows.find(expr);
+    if(r_it==old_rows.end())
+      continue;
+
+    exprt pre_guard=templ[row].pre_guard;
+    remove_unwinding_suffixes(pre_guard);
+    exprt post_guard=templ[row].post_guard;
+    remove_unwinding_suffixes(post_guard);
+    exprt aux_expr=templ[row].aux_expr;
+    remove_unwinding_suffixes(aux_expr);
+    for(const auto &old_row : r_it->second)
+    {
+      const template_rowt &old_templ_row=old_row.second;
+      if(old_templ_row.kind==templ[row].kind &&
+         old_templ_row.pre_guard==pre_guard &&
+         old_templ_row.post_guard==post_guard &&
+         old_templ_row.aux_expr==aux_expr)
+      {
+        value[row]=old_value[old_row.first];
+        restored++;
+        break;
+      }
+    }
+  }
+  return restored;
+}
+
 /*******************************************************************\
 
  Function: tpolyhedra_domaint::template_size
@@ -1058,7 +1161,8 @@ void tpolyhedra_domaint::add_interval_template(
 
 void tpolyhedra_domaint::add_difference_template(
   const var_specst &var_specs,
-  const namespacet &ns)
+  const namespacet &ns,
+  const var_pairst *related)
 {
   std::size_t size=var_specs.size()*(var_specs.size()-1);
   templ.reserve(templ.size()+size);
@@ -1076,6 +1180,11 @@ void tpolyhedra_domaint::add_difference_template(
     {
       if(v2->var.id()==ID_and)
         continue;
+      if(related!=NULL &&
+         related->find(
+           std::make_pair(v1-var_specs.begin(), v2-var_specs.begin()))==
+         related->end())
+        continue;
 
       // Check if both vars are dynamic objects allocated by the same malloc.
       // In such case, do not add the template row, since only one of those is
@@ -1186,7 +1295,8 @@ Function: tpolyhedra_domaint::add_sum_template
 
 void tpolyhedra_domaint::add_sum_template(
   const var_specst &var_specs,
-  const namespacet &ns)
+  const namespacet &ns,
+  const var_pairst *related)
 {
   unsigned size=var_specs.size()*(var_specs.size()-1);
   templ.reserve(templ.size()+size);
@@ -1197,6 +1307,11 @@ void tpolyhedra_domaint::add_sum_template(
     var_specst::const_iterator v2=v1; ++v2;
     for(; v2!=var_specs.end(); ++v2)
     {
+      if(related!=NULL &&
+         related->find(
+           std::make_pair(v1-var_specs.begin(), v2-var_specs.begin()))==
+         related->end())
+        continue;
       kindt k=domaint::merge_kinds(v1->kind, v2->kind);
       if(k==IN)
         continue;
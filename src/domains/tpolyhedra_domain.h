@@ -117,6 +117,18 @@ public:
     exprt &result);
 
   unsigned template_size();
+  const template_rowt &get_template_row(const rowt &row) const
+  {
+    return templ[row];
+  }
+  const templatet &get_template() const { return templ; }
+
+  // warm start: takes the values of the rows that also occur
+  //  in the given template, returns the number of these rows
+  unsigned restore_value(
+    const templatet &old_templ,
+    const templ_valuet &old_value,
+    templ_valuet &value) const;
 
   // generating templates
   template_rowt &add_template_row(
@@ -129,12 +141,15 @@ public:
   void add_interval_template(
     const var_specst &var_specs,
     const namespacet &ns);
+  // if given, rows are only added for the related pairs of variables
   void add_difference_template(
     const var_specst &var_specs,
-    const namespacet &ns);
+    const namespacet &ns,
+    const var_pairst *related=NULL);
   void add_sum_template(
     const var_specst &var_specs,
-    const namespacet &ns);
+    const namespacet &ns,
+    const var_pairst *related=NULL);
   void add_quadratic_template(
     const var_specst &var_specs,
     const namespacet &ns);
@@ -735,3 +735,21 @@ int get_dynobj_line(const irep_idt &id)
   std::string number=name.substr(start, end-start);
   return std::stoi(number);
 }
+
+/*******************************************************************\
+
+Function: message_enabled
+
+  Inputs: message, message level (e.g. messaget::M_DEBUG)
+
+ Outputs: true if messages of the given level are not discarded
+
+ Purpose: diagnostic output that is expensive to format (SSA, summaries,
+          expressions) is only built if it is going to be shown
+
+\*******************************************************************/
+
+bool message_enabled(messaget &message, unsigned level)
+{
+  return message.get_message_handler().get_verbosity()>=level;
+}
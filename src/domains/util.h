@@ -13,6 +13,7 @@ Author: Peter Schrammel
 #include <util/namespace.h>
 #include <util/arith_tools.h>
 #include <util/ieee_float.h>
+#include <util/message.h>
 #include <langapi/language_util.h>
 #include <iostream>
 
@@ -40,4 +41,6 @@ bool is_cprover_symbol(const exprt &expr);
 
 int get_dynobj_line(const irep_idt &id);
 
+bool message_enabled(messaget &message, unsigned level);
+
 #endif
@@ -7,15 +7,25 @@ Author: Peter Schrammel
 \*******************************************************************/
 
 #include <iostream>
+#include <fstream>
+#include <cstdio>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
 
 #include <util/simplify_expr.h>
 #include <solvers/sat/satcheck.h>
 #include <solvers/flattening/bv_pointers.h>
 #include <solvers/smt2/smt2_dec.h>
 #include <util/find_symbols.h>
+#include <util/irep_serialization.h>
+#include <util/tempfile.h>
 
 #include "summarizer_base.h"
 #include "summary_db.h"
+#include "summary_scheduler.h"
 
 #include <domains/ssa_analyzer.h>
 #include <domains/template_generator_summary.h>
@@ -39,6 +49,13 @@ Function: summarizer_baset::summarize
 
 void summarizer_baset::summarize()
 {
+  unsigned jobs=options.get_unsigned_int_option("summary-jobs");
+  if(jobs>1)
+  {
+    summarize_parallel(jobs);
+    return;
+  }
+
   exprt precondition=true_exprt(); // initial calling context
   for(functionst::const_iterator it=ssa_db.functions().begin();
       it!=ssa_db.functions().end(); it++)
@@ -85,6 +102,281 @@ void summarizer_baset::summarize(const function_namet &function_name)
 
 /*******************************************************************\
 
+Function: summarizer_baset::summarize_parallel
+
+  Inputs: maximum number of worker processes
+
+ Outputs:
+
+ Purpose: summarizes all functions bottom-up over the SCCs of the
+          call graph; the SCCs of a level are distributed over
+          forked worker processes that send back their summaries
+          through temporary files (ireps are not thread-safe);
+          summaries are only put into the summary database by
+          the parent process
+
+\*******************************************************************/
+
+void summarizer_baset::summarize_parallel(unsigned jobs)
+{
+  summary_schedulert scheduler(ssa_db);
+  scheduler();
+
+  status() << "Summarizing " << scheduler.sccs.size() << " SCCs in "
+           << scheduler.levels.size() << " levels using up to "
+           << jobs << " processes" << eom;
+
+  for(const auto &level : scheduler.levels)
+  {
+    // distribute the SCCs that need to be (re)computed round-robin
+    std::vector<summary_schedulert::levelt> batches;
+    std::size_t scc_count=0;
+    for(const auto &scc_nr : level)
+    {
+      bool needs_summary=false;
+      for(const auto &f : scheduler.sccs[scc_nr])
+      {
+        if(!summary_db.exists(f) || summary_db.get(f).mark_recompute)
+          needs_summary=true;
+        else
+          status() << "Summary for function " << f
+                   << " exists already" << eom;
+      }
+      if(!needs_summary)
+        continue;
+      if(batches.size()<jobs)
+        batches.push_back(summary_schedulert::levelt());
+      batches[(scc_count++)%jobs].push_back(scc_nr);
+    }
+
+    std::vector<std::string> files(batches.size());
+#ifndef _WIN32
+    std::vector<pid_t> pids(batches.size(), -1);
+    if(batches.size()>1)
+    {
+      std::cout.flush();
+      for(std::size_t b=0; b<batches.size(); ++b)
+      {
+        files[b]=get_temporary_file("2ls_summaries_", ".irep");
+        pids[b]=fork();
+        if(pids[b]!=0)
+          continue;
+
+        // worker process, must not return into the caller
+        try
+        {
+          summarize_worker(scheduler, batches[b], files[b]);
+        }
+        catch(...)
+        {
+          std::cout.flush();
+          _exit(1);
+        }
+      }
+    }
+#endif
+
+    for(std::size_t b=0; b<batches.size(); ++b)
+    {
+      bool done=false;
+#ifndef _WIN32
+      if(pids[b]>0)
+      {
+        int status_code;
+        if(waitpid(pids[b], &status_code, 0)==pids[b] &&
+           WIFEXITED(status_code) && WEXITSTATUS(status_code)==0)
+        {
+          std::ifstream in(files[b], std::ios::binary);
+          irept result;
+          ireps_containert ireps_container;
+          irep_serializationt serializer(ireps_container);
+          serializer.reference_convert(in, result);
+
+          for(const auto &s : result.find("summaries").get_sub())
+          {
+            irep_idt f=s.get(ID_name);
+            summaryt summary;
+            summary.from_irep(s.find("summary"));
+            summary.set_value_domains(ssa_db.get(f));
+            summary_db.put(f, summary);
+            if(s.find("fixpoint").is_not_nil())
+            {
+              summary_dbt::fixpointt fixpoint;
+              fixpoint.from_irep(s.find("fixpoint"));
+              summary_db.set_fixpoint(f, fixpoint);
+            }
+          }
+          solver_instances+=result.get_unsigned_int("solver_instances");
+          solver_calls+=result.get_unsigned_int("solver_calls");
+          solver_rebuilds+=result.get_unsigned_int("solver_rebuilds");
+          context_conversions+=
+            result.get_unsigned_int("context_conversions");
+          reused_literals+=result.get_unsigned_int("reused_literals");
+          summaries_used+=result.get_unsigned_int("summaries_used");
+          termargs_computed+=result.get_unsigned_int("termargs_computed");
+          bound_search_calls+=
+            result.get_unsigned_int("bound_search_calls");
+          bound_search_calls_baseline+=
+            result.get_unsigned_int("bound_search_calls_baseline");
+          solver_profilert::merge(result.find("profile"));
+          done=true;
+        }
+        else
+          warning() << "Summarization process failed, "
+                    << "falling back to sequential summarization" << eom;
+      }
+      if(!files[b].empty())
+        std::remove(files[b].c_str());
+#endif
+
+      if(done)
+        continue;
+
+      // sequential fallback
+      for(const auto &scc_nr : batches[b])
+      {
+        for(const auto &f : scheduler.sccs[scc_nr])
+        {
+          status() << "\nSummarizing function " << f << eom;
+          if(!summary_db.exists(f) || summary_db.get(f).mark_recompute)
+            compute_summary_rec(f, true_exprt(), false);
+        }
+      }
+    }
+  }
+}
+
+/*******************************************************************\
+
+Function: summarizer_baset::summarize_worker
+
+  Inputs: SCCs of the call graph, a batch of them, and the file
+          to write the results to
+
+ Outputs:
+
+ Purpose: body of a worker process of summarize_parallel;
+          computes the summaries of the functions in the batch and
+          writes them together with their fixpoints and what the
+          worker has added to the statistics into the file; exits
+          the process
+
+\*******************************************************************/
+
+void summarizer_baset::summarize_worker(
+  const summary_schedulert &scheduler,
+  const summary_schedulert::levelt &batch,
+  const std::string &file)
+{
+#ifndef _WIN32
+  solver_profilert::clear(); // only send back our own profile
+
+  // the parent has counted everything up to the fork already
+  unsigned solver_instances_before=solver_instances;
+  unsigned solver_calls_before=solver_calls;
+  unsigned solver_rebuilds_before=solver_rebuilds;
+  unsigned context_conversions_before=context_conversions;
+  unsigned reused_literals_before=reused_literals;
+  unsigned summaries_used_before=summaries_used;
+  unsigned termargs_computed_before=termargs_computed;
+  unsigned bound_search_calls_before=bound_search_calls;
+  unsigned bound_search_calls_baseline_before=bound_search_calls_baseline;
+
+  // the solvers of the parent do not see our calls
+  struct solver_statst
+  {
+    unsigned calls, rebuilds, context_conversions, reused_literals;
+  };
+  std::map<function_namet, solver_statst> solver_stats;
+  for(const auto &solver : ssa_db.solvers())
+  {
+    solver_statst &stats=solver_stats[solver.first];
+    stats.calls=solver.second->get_number_of_solver_calls();
+    stats.rebuilds=solver.second->get_number_of_rebuilds();
+    stats.context_conversions=
+      solver.second->get_number_of_context_conversions();
+    stats.reused_literals=solver.second->get_number_of_reused_literals();
+  }
+
+  for(const auto &scc_nr : batch)
+  {
+    for(const auto &f : scheduler.sccs[scc_nr])
+    {
+      status() << "\nSummarizing function " << f << eom;
+      if(!summary_db.exists(f) || summary_db.get(f).mark_recompute)
+        compute_summary_rec(f, true_exprt(), false);
+    }
+  }
+
+  irept result;
+  irept::subt &summaries=result.add("summaries").get_sub();
+  for(const auto &scc_nr : batch)
+  {
+    for(const auto &f : scheduler.sccs[scc_nr])
+    {
+      irept s;
+      s.set(ID_name, f);
+      s.add("summary")=summary_db.get(f).to_irep();
+      if(summary_db.has_fixpoint(f))
+        s.add("fixpoint")=summary_db.get_fixpoint(f).to_irep();
+      summaries.push_back(s);
+    }
+  }
+
+  unsigned worker_solver_instances=solver_instances-solver_instances_before;
+  unsigned worker_solver_calls=solver_calls-solver_calls_before;
+  unsigned worker_solver_rebuilds=solver_rebuilds-solver_rebuilds_before;
+  unsigned worker_context_conversions=
+    context_conversions-context_conversions_before;
+  unsigned worker_reused_literals=reused_literals-reused_literals_before;
+  for(const auto &solver : ssa_db.solvers())
+  {
+    // zero for solvers created by the worker
+    const solver_statst &before=solver_stats[solver.first];
+    unsigned calls=solver.second->get_number_of_solver_calls();
+    if(before.calls==0 && calls>0)
+      worker_solver_instances++;
+    worker_solver_calls+=calls-before.calls;
+    worker_solver_rebuilds+=
+      solver.second->get_number_of_rebuilds()-before.rebuilds;
+    worker_context_conversions+=
+      solver.second->get_number_of_context_conversions()-
+      before.context_conversions;
+    worker_reused_literals+=
+      solver.second->get_number_of_reused_literals()-before.reused_literals;
+  }
+
+  result.set("solver_instances", worker_solver_instances);
+  result.set("solver_calls", worker_solver_calls);
+  result.set("solver_rebuilds", worker_solver_rebuilds);
+  result.set("context_conversions", worker_context_conversions);
+  result.set("reused_literals", worker_reused_literals);
+  result.set("summaries_used", summaries_used-summaries_used_before);
+  result.set(
+    "termargs_computed",
+    termargs_computed-termargs_computed_before);
+  result.set(
+    "bound_search_calls",
+    bound_search_calls-bound_search_calls_before);
+  result.set(
+    "bound_search_calls_baseline",
+    bound_search_calls_baseline-bound_search_calls_baseline_before);
+  if(solver_profilert::is_enabled())
+    result.add("profile")=solver_profilert::to_irep();
+
+  std::ofstream out(file, std::ios::binary);
+  ireps_containert ireps_container;
+  irep_serializationt serializer(ireps_container);
+  serializer.reference_convert(result, out);
+  out.close();
+
+  std::cout.flush();
+  _exit(out.fail() ? 1 : 0);
+#endif
+}
+
+/*******************************************************************\
+
 Function: summarizer_baset::check_call_reachable
 
   Inputs:
@@ -111,6 +403,7 @@ bool summarizer_baset::check_call_reachable(
   bool reachable=false;
 
   // reachability check
+  solver_profilert::phaset profiler_phase("reachability");
   incremental_solvert &solver=ssa_db.get_solver(function_name);
   solver.set_message_handler(get_message_handler());
   solver << SSA;
@@ -238,6 +531,9 @@ exprt summarizer_baset::compute_calling_context(
   // statistics
   solver_instances+=analyzer.get_number_of_solver_instances();
   solver_calls+=analyzer.get_number_of_solver_calls();
+  bound_search_calls+=analyzer.get_number_of_bound_search_calls();
+  bound_search_calls_baseline+=
+    analyzer.get_number_of_bound_search_calls_baseline();
 
   solver.pop_context();
 
@@ -346,6 +642,7 @@ bool summarizer_baset::check_precondition(
 
   // precondition check
   // solver
+  solver_profilert::phaset profiler_phase("precondition");
   incremental_solvert &solver=ssa_db.get_solver(function_name);
   solver.set_message_handler(get_message_handler());
   solver << SSA;
@@ -403,6 +700,7 @@ bool summarizer_baset::check_end_reachable(
   local_SSAt &SSA,
   const exprt &cond)
 {
+  solver_profilert::phaset profiler_phase("reachability");
   incremental_solvert &solver=ssa_db.get_solver(function_name);
   solver.set_message_handler(get_message_handler());
   solver << SSA;
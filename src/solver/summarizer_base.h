@@ -18,6 +18,8 @@ Author: Peter Schrammel
 #include <ssa/local_ssa.h>
 #include <ssa/ssa_db.h>
 
+#include "summary_scheduler.h"
+
 class summarizer_baset:public messaget
 {
 public:
@@ -34,8 +36,13 @@ public:
     ssa_inliner(_ssa_inliner),
     solver_instances(0),
     solver_calls(0),
+    solver_rebuilds(0),
+    context_conversions(0),
+    reused_literals(0),
     summaries_used(0),
-    termargs_computed(0)
+    termargs_computed(0),
+    bound_search_calls(0),
+    bound_search_calls_baseline(0)
   {
   }
 
@@ -51,8 +58,16 @@ public:
 
   unsigned get_number_of_solver_instances() { return solver_instances; }
   unsigned get_number_of_solver_calls() { return solver_calls; }
+  // rebuilds of solvers in worker processes of summarize_parallel
+  unsigned get_number_of_solver_rebuilds() { return solver_rebuilds; }
+  unsigned get_number_of_context_conversions()
+    { return context_conversions; }
+  unsigned get_number_of_reused_literals() { return reused_literals; }
   unsigned get_number_of_summaries_used() { return summaries_used; }
   unsigned get_number_of_termargs_computed() { return termargs_computed; }
+  unsigned get_number_of_bound_search_calls() { return bound_search_calls; }
+  unsigned get_number_of_bound_search_calls_baseline()
+    { return bound_search_calls_baseline; }
 
  protected:
   optionst &options;
@@ -61,6 +76,14 @@ public:
   ssa_unwindert &ssa_unwinder;
   ssa_inlinert &ssa_inliner;
 
+  // summarizes the independent SCCs of each level of the call graph
+  //  in parallel worker processes
+  void summarize_parallel(unsigned jobs);
+  void summarize_worker(
+    const summary_schedulert &scheduler,
+    const summary_schedulert::levelt &batch,
+    const std::string &file);
+
   virtual void compute_summary_rec(
     const function_namet &function_name,
     const exprt &precondition,
@@ -105,8 +128,13 @@ public:
   // statistics
   unsigned solver_instances;
   unsigned solver_calls;
+  unsigned solver_rebuilds;
+  unsigned context_conversions;
+  unsigned reused_literals;
   unsigned summaries_used;
   unsigned termargs_computed;
+  unsigned bound_search_calls;
+  unsigned bound_search_calls_baseline;
 };
 
 
@@ -18,6 +18,7 @@ Author: Peter Schrammel
 #include <util/find_symbols.h>
 
 #include <domains/ssa_analyzer.h>
+#include <domains/util.h>
 #include <domains/template_generator_summary.h>
 #include <domains/template_generator_callingcontext.h>
 #include <domains/template_generator_ranking.h>
@@ -102,6 +103,7 @@ void summarizer_bwt::compute_summary_rec(
   bool context_sensitive)
 {
   local_SSAt &SSA=ssa_db.get(function_name);
+  solver_profilert::functiont profiler_function(function_name);
 
   const summaryt &old_summary=summary_db.get(function_name);
 
@@ -131,6 +133,7 @@ void summarizer_bwt::compute_summary_rec(
   // store summary in db
   summary_db.put(function_name, summary);
 
+  if(message_enabled(*this, M_STATUS))
   {
     std::ostringstream out;
     out << std::endl << "Summary for function " << function_name << std::endl;
@@ -199,12 +202,16 @@ void summarizer_bwt::do_summary(
     // statistics
     solver_instances+=analyzer.get_number_of_solver_instances();
     solver_calls+=analyzer.get_number_of_solver_calls();
+    bound_search_calls+=analyzer.get_number_of_bound_search_calls();
+    bound_search_calls_baseline+=
+      analyzer.get_number_of_bound_search_calls_baseline();
   }
 #if 1
   // TODO: yet another workaround for ssa_analyzer
   // not being able to handle empty templates properly
   else
   {
+    solver_profilert::phaset profiler_phase("reachability");
     solver << SSA;
     solver.new_context();
     solver << SSA.get_enabling_exprs();
@@ -403,6 +410,7 @@ bool summarizer_bwt::check_postcondition(
 
   // postcondition check
   // solver
+  solver_profilert::phaset profiler_phase("precondition");
   incremental_solvert &solver=ssa_db.get_solver(function_name);
   solver.set_message_handler(get_message_handler());
   solver << SSA;
@@ -536,6 +544,9 @@ exprt summarizer_bwt::compute_calling_context2(
   // statistics
   solver_instances+=analyzer.get_number_of_solver_instances();
   solver_calls+=analyzer.get_number_of_solver_calls();
+  bound_search_calls+=analyzer.get_number_of_bound_search_calls();
+  bound_search_calls_baseline+=
+    analyzer.get_number_of_bound_search_calls_baseline();
 
   return postcondition_call;
 }
@@ -17,6 +17,7 @@ Author: Peter Schrammel
 #include <util/find_symbols.h>
 
 #include <domains/ssa_analyzer.h>
+#include <domains/util.h>
 #include <domains/template_generator_callingcontext.h>
 
 #include <ssa/local_ssa.h>
@@ -47,6 +48,7 @@ void summarizer_bw_termt::compute_summary_rec(
   bool context_sensitive)
 {
   local_SSAt &SSA=ssa_db.get(function_name);
+  solver_profilert::functiont profiler_function(function_name);
 
   const summaryt &old_summary=summary_db.get(function_name);
 
@@ -95,6 +97,7 @@ void summarizer_bw_termt::compute_summary_rec(
   // store summary in db
   summary_db.put(function_name, summary);
 
+  if(message_enabled(*this, M_STATUS))
   {
     std::ostringstream out;
     out << std::endl << "Summary for function " << function_name << std::endl;
@@ -327,6 +330,7 @@ bool summarizer_bw_termt::bootstrap_preconditions(
 
   unsigned number_bootstraps=0;
   termination_argument=true_exprt();
+  solver_profilert::phaset profiler_phase("bootstrap");
   exprt::operandst checked_candidates;
   while(number_bootstraps++<MAX_BOOTSTRAP_ATTEMPTS)
   {
@@ -405,6 +409,9 @@ exprt summarizer_bw_termt::compute_termination_argument(
   // statistics
   solver_instances+=analyzer.get_number_of_solver_instances();
   solver_calls+=analyzer.get_number_of_solver_calls();
+  bound_search_calls+=analyzer.get_number_of_bound_search_calls();
+  bound_search_calls_baseline+=
+    analyzer.get_number_of_bound_search_calls_baseline();
   termargs_computed++;
 
   return termination_argument;
@@ -446,12 +453,16 @@ exprt summarizer_bw_termt::compute_precondition(
     // statistics
     solver_instances+=analyzer.get_number_of_solver_instances();
     solver_calls+=analyzer.get_number_of_solver_calls();
+    bound_search_calls+=analyzer.get_number_of_bound_search_calls();
+    bound_search_calls_baseline+=
+      analyzer.get_number_of_bound_search_calls_baseline();
   }
 #if 1
   // TODO: yet another workaround for ssa_analyzer
   //  not being able to handle empty templates properly
   else
   {
+    solver_profilert::phaset profiler_phase("reachability");
     solver << SSA;
     solver.new_context();
     solver << SSA.get_enabling_exprs();
@@ -17,6 +17,7 @@ Author: Peter Schrammel
 #include "summarizer_fw.h"
 
 #include <domains/ssa_analyzer.h>
+#include <domains/util.h>
 #include <domains/template_generator_summary.h>
 
 // #define SHOW_WHOLE_RESULT
@@ -39,6 +40,7 @@ void summarizer_fwt::compute_summary_rec(
   bool context_sensitive)
 {
   local_SSAt &SSA=ssa_db.get(function_name); // TODO: make const
+  solver_profilert::functiont profiler_function(function_name);
 
   // recursively compute summaries for function calls
   inline_summaries(function_name, SSA, precondition, context_sensitive);
@@ -88,7 +90,8 @@ void summarizer_fwt::compute_summary_rec(
   // store summary in db
   summary_db.put(function_name, summary);
 
-  if(!options.get_bool_option("competition-mode"))
+  if(!options.get_bool_option("competition-mode") &&
+     message_enabled(*this, M_STATUS))
   {
     std::ostringstream out;
     out << std::endl << "Summary for function " << function_name << std::endl;
@@ -137,28 +140,49 @@ void summarizer_fwt::do_summary(
   conds.push_back(summary.fw_precondition);
   conds.push_back(ssa_inliner.get_summaries(SSA));
 
-#ifdef REUSE_INVARIANTS
-  if(summary_db.exists(function_name)) // reuse existing invariants
-  {
-    const exprt &old_inv=summary_db.get(function_name).fw_invariant;
-    exprt inv=ssa_unwinder.get(function_name).rename_invariant(old_inv);
-    conds.push_back(inv);
-
-#if 0
-    std::ostringstream out;
-    out << "(original inv)" << from_expr(SSA.ns, "", old_inv) << "\n";
-    debug() << out.str() << eom;
-    out << "(renamed inv)" << from_expr(SSA.ns, "", inv) << "\n";
-    debug() << out.str() << eom;
-#endif
-  }
-#endif
-
   cond=conjunction(conds);
 
+  // the loops that do not depend on each other are analyzed first,
+  //  the remaining analysis only computes the input and output rows
+  bool warm_start=options.get_bool_option("warm-start");
+  const summary_dbt::fixpointt *previous_fixpoint=
+    warm_start && summary_db.has_fixpoint(function_name) ?
+    &summary_db.get_fixpoint(function_name) : NULL;
+  exprt loops_invariant, loops_constraint;
+  summary_dbt::fixpointt loops_fixpoint;
+  bool independent_loops=
+    options.get_bool_option("independent-loops") &&
+    analyze_independent_loops(
+      function_name, SSA, cond, solver, template_generator,
+      previous_fixpoint, loops_invariant, loops_constraint, loops_fixpoint);
+  if(independent_loops)
+    cond=and_exprt(cond, loops_constraint);
+  if(previous_fixpoint!=NULL)
+    analyzer.set_warm_start(*previous_fixpoint);
+
   analyzer(solver, SSA, cond, template_generator);
   analyzer.get_result(summary.fw_transformer, template_generator.inout_vars());
-  analyzer.get_result(summary.fw_invariant, template_generator.loop_vars());
+  if(independent_loops)
+    summary.fw_invariant=loops_invariant;
+  else
+    analyzer.get_result(summary.fw_invariant, template_generator.loop_vars());
+
+  if(warm_start)
+  {
+    summary_dbt::fixpointt fixpoint;
+    if(analyzer.get_fixpoint(fixpoint))
+    {
+      fixpoint.templ.insert(
+        fixpoint.templ.end(),
+        loops_fixpoint.templ.begin(),
+        loops_fixpoint.templ.end());
+      fixpoint.templ_value.insert(
+        fixpoint.templ_value.end(),
+        loops_fixpoint.templ_value.begin(),
+        loops_fixpoint.templ_value.end());
+      summary_db.set_fixpoint(function_name, fixpoint);
+    }
+  }
 
 #ifdef SHOW_WHOLE_RESULT
   // to see all the custom template values
@@ -187,6 +211,9 @@ void summarizer_fwt::do_summary(
 
   solver_instances+=analyzer.get_number_of_solver_instances();
   solver_calls+=analyzer.get_number_of_solver_calls();
+  bound_search_calls+=analyzer.get_number_of_bound_search_calls();
+  bound_search_calls_baseline+=
+    analyzer.get_number_of_bound_search_calls_baseline();
 
   if (options.get_bool_option("show-imprecise-vars"))
   {
@@ -198,6 +225,102 @@ void summarizer_fwt::do_summary(
 
 /*******************************************************************\
 
+Function: summarizer_fwt::analyze_independent_loops
+
+  Inputs: SSA, constraints and template generator of the function,
+          fixpoint of the previous analysis to start from (or NULL)
+
+ Outputs: false if the loops cannot be analyzed separately,
+          otherwise the invariant of the loops, the constraint
+          that their values hold at the loop heads, and their
+          fixpoints
+
+ Purpose: analyzes groups of loops that do not depend on each other
+          in separate domains and solver contexts; the template of
+          the given generator is restricted to the remaining rows,
+          i.e. those of the input and output variables
+
+\*******************************************************************/
+
+bool summarizer_fwt::analyze_independent_loops(
+  const function_namet &function_name,
+  local_SSAt &SSA,
+  const exprt &cond,
+  incremental_solvert &solver,
+  template_generator_summaryt &template_generator,
+  const summary_dbt::fixpointt *previous_fixpoint,
+  exprt &invariant,
+  exprt &constraint,
+  summary_dbt::fixpointt &fixpoint)
+{
+  std::vector<domaint::var_specst> loop_groups;
+  template_generator.get_independent_loops(SSA, loop_groups);
+  if(loop_groups.empty())
+    return false;
+
+  status() << "Analyzing " << loop_groups.size()
+           << " groups of independent loops" << eom;
+
+  exprt::operandst invariants, constraints;
+  for(const auto &loop_group : loop_groups)
+  {
+    template_generator_summaryt loop_template_generator(
+      options, ssa_db, ssa_unwinder.get(function_name));
+    loop_template_generator.set_message_handler(get_message_handler());
+    loop_template_generator(solver.next_domain_number(), SSA, true);
+    loop_template_generator.restrict_template(SSA, loop_group);
+
+    ssa_analyzert analyzer;
+    analyzer.set_message_handler(get_message_handler());
+    if(previous_fixpoint!=NULL)
+      analyzer.set_warm_start(*previous_fixpoint);
+    analyzer(solver, SSA, cond, loop_template_generator);
+
+    solver_instances+=analyzer.get_number_of_solver_instances();
+    solver_calls+=analyzer.get_number_of_solver_calls();
+    bound_search_calls+=analyzer.get_number_of_bound_search_calls();
+    bound_search_calls_baseline+=
+      analyzer.get_number_of_bound_search_calls_baseline();
+
+    // get_independent_loops groups loops only for domains
+    //  that have a fixpoint
+    summary_dbt::fixpointt loop_fixpoint;
+    bool has_fixpoint=analyzer.get_fixpoint(loop_fixpoint);
+    assert(has_fixpoint && !loop_fixpoint.heap_value);
+
+    exprt loop_invariant;
+    analyzer.get_result(loop_invariant, loop_template_generator.loop_vars());
+    invariants.push_back(loop_invariant);
+    constraints.push_back(
+      static_cast<tpolyhedra_domaint *>(loop_template_generator.domain())
+        ->to_pre_constraints(loop_fixpoint.templ_value));
+
+    fixpoint.templ.insert(
+      fixpoint.templ.end(),
+      loop_fixpoint.templ.begin(),
+      loop_fixpoint.templ.end());
+    fixpoint.templ_value.insert(
+      fixpoint.templ_value.end(),
+      loop_fixpoint.templ_value.begin(),
+      loop_fixpoint.templ_value.end());
+  }
+  invariant=conjunction(invariants);
+  constraint=conjunction(constraints);
+
+  // the loop rows are known now
+  domaint::var_specst inout_var_specs;
+  for(const auto &v : template_generator.var_specs)
+  {
+    if(v.kind!=domaint::LOOP)
+      inout_var_specs.push_back(v);
+  }
+  template_generator.restrict_template(SSA, inout_var_specs);
+
+  return true;
+}
+
+/*******************************************************************\
+
 Function: summarizer_fwt::inline_summaries
 
   Inputs:
@@ -17,6 +17,7 @@ Author: Peter Schrammel
 #include <ssa/ssa_unwinder.h>
 #include <ssa/local_ssa.h>
 #include <ssa/ssa_db.h>
+#include <domains/template_generator_summary.h>
 
 #include "summarizer_base.h"
 
@@ -51,6 +52,17 @@ protected:
     summaryt &summary,
     exprt cond, // additional constraints
     bool forward);
+
+  bool analyze_independent_loops(
+    const function_namet &function_name,
+    local_SSAt &SSA,
+    const exprt &cond,
+    incremental_solvert &solver,
+    template_generator_summaryt &template_generator,
+    const summary_dbt::fixpointt *previous_fixpoint,
+    exprt &invariant,
+    exprt &constraint,
+    summary_dbt::fixpointt &fixpoint);
 };
 
 #endif
@@ -15,6 +15,7 @@ Author: Peter Schrammel
 #include <util/find_symbols.h>
 
 #include <domains/ssa_analyzer.h>
+#include <domains/util.h>
 #include <domains/template_generator_summary.h>
 #include <domains/template_generator_callingcontext.h>
 #include <domains/template_generator_ranking.h>
@@ -50,6 +51,7 @@ void summarizer_fw_termt::compute_summary_rec(
   }
 
   local_SSAt &SSA=ssa_db.get(function_name);
+  solver_profilert::functiont profiler_function(function_name);
 
   // recursively compute summaries for function calls
   threevalt calls_terminate=YES;
@@ -64,6 +66,7 @@ void summarizer_fw_termt::compute_summary_rec(
 
   status() << "Analyzing function "  << function_name << eom;
 
+  if(message_enabled(*this, M_DEBUG))
   {
     std::ostringstream out;
     out << "Function body for " << function_name <<
@@ -148,6 +151,7 @@ void summarizer_fw_termt::compute_summary_rec(
       do_termination(function_name, SSA, summary);
     }
   }
+  if(message_enabled(*this, M_STATUS))
   {
     std::ostringstream out;
     out << std::endl << "Summary for function " << function_name << std::endl;
@@ -320,6 +324,9 @@ void summarizer_fw_termt::do_termination(
   // statistics
   solver_instances+=analyzer1.get_number_of_solver_instances();
   solver_calls+=analyzer1.get_number_of_solver_calls();
+  bound_search_calls+=analyzer1.get_number_of_bound_search_calls();
+  bound_search_calls_baseline+=
+    analyzer1.get_number_of_bound_search_calls_baseline();
   termargs_computed++;
 }
 
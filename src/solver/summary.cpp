@@ -197,6 +197,109 @@ void summaryt::set_value_domains(const local_SSAt &SSA)
 
 /*******************************************************************\
 
+Function: summaryt::to_irep
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: converts the summary into an irep for serialization
+
+\*******************************************************************/
+
+irept summaryt::to_irep() const
+{
+  irept dest;
+
+  irept::subt &params_sub=dest.add("params").get_sub();
+  for(const auto &p : params)
+    params_sub.push_back(p);
+  irept::subt &globals_in_sub=dest.add("globals_in").get_sub();
+  for(const auto &g : globals_in)
+    globals_in_sub.push_back(g);
+  irept::subt &globals_out_sub=dest.add("globals_out").get_sub();
+  for(const auto &g : globals_out)
+    globals_out_sub.push_back(g);
+
+  dest.add("fw_precondition")=fw_precondition;
+  dest.add("fw_transformer")=fw_transformer;
+  dest.add("fw_invariant")=fw_invariant;
+  dest.add("bw_precondition")=bw_precondition;
+  dest.add("bw_postcondition")=bw_postcondition;
+  dest.add("bw_transformer")=bw_transformer;
+  dest.add("bw_invariant")=bw_invariant;
+  dest.add("aux_precondition")=aux_precondition;
+  dest.add("termination_argument")=termination_argument;
+  dest.set("terminates", static_cast<long long>(terminates));
+  dest.set("mark_recompute", mark_recompute);
+  dest.set("opt_imprecise", opt_imprecise);
+
+  irept::subt &imprecise_sub=dest.add("imprecise_vars").get_sub();
+  for(const auto &var : imprecise_vars_summary)
+  {
+    irept v;
+    v.set("pretty_name", var.pretty_name);
+    v.set("loophead_loc", var.loophead_loc);
+    v.set("dyn_mem_field", var.dyn_mem_field);
+    v.set("dyn_alloc_loc", var.dyn_alloc_loc);
+    imprecise_sub.push_back(v);
+  }
+
+  return dest;
+}
+
+/*******************************************************************\
+
+Function: summaryt::from_irep
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: restores the summary from an irep created by to_irep
+
+\*******************************************************************/
+
+void summaryt::from_irep(const irept &irep)
+{
+  params.clear();
+  for(const auto &p : irep.find("params").get_sub())
+    params.push_back(to_symbol_expr(static_cast<const exprt &>(p)));
+  globals_in.clear();
+  for(const auto &g : irep.find("globals_in").get_sub())
+    globals_in.insert(to_symbol_expr(static_cast<const exprt &>(g)));
+  globals_out.clear();
+  for(const auto &g : irep.find("globals_out").get_sub())
+    globals_out.insert(to_symbol_expr(static_cast<const exprt &>(g)));
+
+  fw_precondition=static_cast<const exprt &>(irep.find("fw_precondition"));
+  fw_transformer=static_cast<const exprt &>(irep.find("fw_transformer"));
+  fw_invariant=static_cast<const exprt &>(irep.find("fw_invariant"));
+  bw_precondition=static_cast<const exprt &>(irep.find("bw_precondition"));
+  bw_postcondition=static_cast<const exprt &>(irep.find("bw_postcondition"));
+  bw_transformer=static_cast<const exprt &>(irep.find("bw_transformer"));
+  bw_invariant=static_cast<const exprt &>(irep.find("bw_invariant"));
+  aux_precondition=static_cast<const exprt &>(irep.find("aux_precondition"));
+  termination_argument=
+    static_cast<const exprt &>(irep.find("termination_argument"));
+  terminates=static_cast<threevalt>(irep.get_long_long("terminates"));
+  mark_recompute=irep.get_bool("mark_recompute");
+  opt_imprecise=irep.get_bool("opt_imprecise");
+
+  imprecise_vars_summary.clear();
+  for(const auto &v : irep.find("imprecise_vars").get_sub())
+  {
+    imprecise_vart var;
+    var.pretty_name=v.get("pretty_name");
+    var.loophead_loc=v.get("loophead_loc");
+    var.dyn_mem_field=v.get("dyn_mem_field");
+    var.dyn_alloc_loc=v.get("dyn_alloc_loc");
+    imprecise_vars_summary.push_back(var);
+  }
+}
+
+/*******************************************************************\
+
 Function: summaryt::out_invariant_imprecise_vars
 
   Inputs: Output stream
@@ -75,6 +75,11 @@ class summaryt
 
   void set_value_domains(const local_SSAt &SSA);
 
+  // (de)serialization, value domains are not included
+  //   and must be set from the SSA again
+  irept to_irep() const;
+  void from_irep(const irept &irep);
+
 
   imprecise_varst imprecise_vars_summary;
 
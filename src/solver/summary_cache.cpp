@@ -0,0 +1,409 @@
+/*******************************************************************\
+
+Module: Persistent Cache for Function Summaries
+
+Author: Peter Schrammel
+
+\*******************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+
+#include <util/irep_serialization.h>
+
+#include "summary_cache.h"
+#include "summary_scheduler.h"
+
+// bump when the summary format or the analyses change
+#define SUMMARY_CACHE_VERSION "2ls-summary-cache-1"
+
+/*******************************************************************\
+
+Function: hash_string
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: FNV-1a, stable across runs unlike irep hashes, which
+          depend on the numbering of strings
+
+\*******************************************************************/
+
+static void hash_string(
+  summary_cachet::keyt &h,
+  const std::string &s)
+{
+  for(const auto &c : s)
+  {
+    h^=static_cast<unsigned char>(c);
+    h*=1099511628211ULL;
+  }
+  // separator
+  h^=0xff;
+  h*=1099511628211ULL;
+}
+
+/*******************************************************************\
+
+Function: hash_key
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static void hash_key(
+  summary_cachet::keyt &h,
+  summary_cachet::keyt key)
+{
+  for(unsigned i=0; i<sizeof(key); ++i)
+  {
+    h^=(key>>(8*i))&0xff;
+    h*=1099511628211ULL;
+  }
+}
+
+/*******************************************************************\
+
+Function: summary_cachet::hash_irep
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: stable hash of an irep ignoring comments (e.g. source
+          locations); the hashes of shared subtrees are memoized
+          by the address of their data
+
+\*******************************************************************/
+
+summary_cachet::keyt summary_cachet::hash_irep(const irept &irep)
+{
+  // identical ireps share their subs, unless they are empty
+  const void *data=&irep.get_sub();
+  bool memoize=!irep.get_sub().empty() || !irep.get_named_sub().empty();
+  if(memoize)
+  {
+    irep_hashest::const_iterator h_it=irep_hashes.find(data);
+    if(h_it!=irep_hashes.end())
+      return h_it->second;
+  }
+
+  keyt h=14695981039346656037ULL;
+  hash_string(h, id2string(irep.id()));
+
+  for(const auto &sub : irep.get_sub())
+    hash_key(h, hash_irep(sub));
+
+  // the order of named_sub depends on the string numbering
+  std::vector<std::pair<std::string, keyt> > named;
+  for(const auto &n : irep.get_named_sub())
+  {
+    const std::string &name=id2string(n.first);
+    if(!name.empty() && name[0]=='#')
+      continue;
+    named.push_back(std::make_pair(name, hash_irep(n.second)));
+  }
+  std::sort(named.begin(), named.end());
+  for(const auto &n : named)
+  {
+    hash_string(h, n.first);
+    hash_key(h, n.second);
+  }
+
+  if(memoize)
+    irep_hashes[data]=h;
+  return h;
+}
+
+/*******************************************************************\
+
+Function: summary_cachet::options_key
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: hash of the options that influence the summaries
+
+\*******************************************************************/
+
+summary_cachet::keyt summary_cachet::options_key(
+  bool forward,
+  bool termination)
+{
+  static const char *relevant_options[]=
+  {
+    "intervals", "zones", "octagons", "equalities", "qzones",
+    "heap", "heap-interval", "heap-zones", "heap-values-refine",
+    "sympath", "enum-solver", "binsearch-solver", "arrays", "havoc",
+    "preconditions", "sufficient", "termination", "nontermination",
+    "lexicographic-ranking-function", "monolithic-ranking-function",
+    "max-inner-ranking-iterations", "give-up-invariants",
+    "inline", "inline-partial", "k-induction", "incremental-bmc",
+    "unwind", "unwindset", "incremental", "constant-propagation",
+    "competition-mode", "refine", "sparse-templates", "warm-start",
+    "independent-loops"
+  };
+
+  keyt h=14695981039346656037ULL;
+  hash_string(h, SUMMARY_CACHE_VERSION);
+  hash_string(h, forward ? "forward" : "backward");
+  hash_string(h, termination ? "termination" : "");
+  for(const auto &o : relevant_options)
+  {
+    hash_string(h, o);
+    hash_string(h, options.get_option(o));
+  }
+  return h;
+}
+
+/*******************************************************************\
+
+Function: summary_cachet::ssa_key
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: hash of the (unwound) SSA of a function
+
+\*******************************************************************/
+
+summary_cachet::keyt summary_cachet::ssa_key(const local_SSAt &SSA)
+{
+  keyt h=14695981039346656037ULL;
+
+  for(const auto &p : SSA.params)
+    hash_key(h, hash_irep(p));
+  for(const auto &g : SSA.globals_in)
+    hash_key(h, hash_irep(g));
+  for(const auto &g : SSA.globals_out)
+    hash_key(h, hash_irep(g));
+
+  for(const auto &node : SSA.nodes)
+  {
+    // SSA names contain the location numbers
+    hash_key(h, node.location->location_number);
+    if(node.loophead!=SSA.nodes.end())
+      hash_key(h, node.loophead->location->location_number);
+    for(const auto &e : node.equalities)
+      hash_key(h, hash_irep(e));
+    for(const auto &c : node.constraints)
+      hash_key(h, hash_irep(c));
+    for(const auto &a : node.assertions)
+      hash_key(h, hash_irep(a));
+    for(const auto &f : node.function_calls)
+      hash_key(h, hash_irep(f));
+    for(const auto &t : node.templates)
+      hash_key(h, hash_irep(t));
+    hash_key(h, hash_irep(node.enabling_expr));
+  }
+
+  return h;
+}
+
+/*******************************************************************\
+
+Function: summary_cachet::compute_keys
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the key of a function depends on the options, on the SSA
+          of the functions in its SCC of the call graph, and on the
+          keys of the callees
+
+\*******************************************************************/
+
+void summary_cachet::compute_keys(bool forward, bool termination)
+{
+  keys.clear();
+  keyt opt_key=options_key(forward, termination);
+
+  summary_schedulert scheduler(ssa_db);
+  scheduler();
+  const summary_schedulert::call_grapht &call_graph=
+    scheduler.get_call_graph();
+
+  // the SCCs are ordered bottom-up
+  for(const auto &scc : scheduler.sccs)
+  {
+    std::set<function_namet> members(scc.begin(), scc.end());
+    keyt scc_key=opt_key;
+    std::vector<keyt> callee_keys;
+    for(const auto &f : scc)
+    {
+      hash_string(scc_key, id2string(f));
+      hash_key(scc_key, ssa_key(ssa_db.get(f)));
+      for(const auto &callee : call_graph.at(f))
+      {
+        if(members.find(callee)==members.end())
+          callee_keys.push_back(keys.at(callee));
+      }
+    }
+    std::sort(callee_keys.begin(), callee_keys.end());
+    for(const auto &k : callee_keys)
+      hash_key(scc_key, k);
+
+    for(const auto &f : scc)
+    {
+      keyt key=scc_key;
+      hash_string(key, id2string(f));
+      keys[f]=key;
+    }
+  }
+
+  // the SSAs change when they are unwound, freeing their data
+  irep_hashes.clear();
+}
+
+/*******************************************************************\
+
+Function: summary_cachet::load
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void summary_cachet::load(bool forward, bool termination)
+{
+  compute_keys(forward, termination);
+  missed.clear();
+
+  for(const auto &k : keys)
+  {
+    const function_namet &f=k.first;
+    bool needs_summary=forward ?
+      (!summary_db.exists(f) || summary_db.get(f).mark_recompute) :
+      (summary_db.exists(f) && summary_db.get(f).bw_precondition.is_nil());
+    if(!needs_summary)
+      continue;
+
+    if(read(f, k.second))
+    {
+      hits++;
+      status() << "Summary for function " << f
+               << " loaded from cache" << eom;
+    }
+    else
+    {
+      misses++;
+      missed.insert(f);
+    }
+  }
+}
+
+/*******************************************************************\
+
+Function: summary_cachet::store
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void summary_cachet::store()
+{
+  for(const auto &f : missed)
+  {
+    if(summary_db.exists(f) && !summary_db.get(f).mark_recompute)
+      write(f, keys.at(f));
+  }
+  missed.clear();
+}
+
+/*******************************************************************\
+
+Function: summary_cachet::file_name
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::string summary_cachet::file_name(keyt key)
+{
+  std::ostringstream s;
+  s << directory << "/summary." << std::hex << std::setw(16)
+    << std::setfill('0') << key;
+  return s.str();
+}
+
+/*******************************************************************\
+
+Function: summary_cachet::read
+
+  Inputs:
+
+ Outputs: true if the summary has been loaded
+
+ Purpose:
+
+\*******************************************************************/
+
+bool summary_cachet::read(const function_namet &function_name, keyt key)
+{
+  std::ifstream in(file_name(key), std::ios::binary);
+  if(!in)
+    return false;
+
+  irept irep;
+  ireps_containert ireps_container;
+  irep_serializationt serializer(ireps_container);
+  serializer.reference_convert(in, irep);
+  if(in.fail() || irep.get(ID_name)!=function_name)
+    return false;
+
+  summaryt summary;
+  summary.from_irep(irep.find("summary"));
+  summary.mark_recompute=false;
+  summary.set_value_domains(ssa_db.get(function_name));
+  summary_db.set(function_name, summary);
+  return true;
+}
+
+/*******************************************************************\
+
+Function: summary_cachet::write
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void summary_cachet::write(const function_namet &function_name, keyt key)
+{
+  irept irep;
+  irep.set(ID_name, function_name);
+  irep.add("summary")=summary_db.get(function_name).to_irep();
+
+  std::string file=file_name(key);
+  std::ofstream out(file, std::ios::binary);
+  ireps_containert ireps_container;
+  irep_serializationt serializer(ireps_container);
+  serializer.reference_convert(irep, out);
+  if(!out)
+    warning() << "Failed to write summary cache file " << file << eom;
+}
@@ -0,0 +1,80 @@
+/*******************************************************************\
+
+Module: Persistent Cache for Function Summaries
+
+Author: Peter Schrammel
+
+\*******************************************************************/
+
+#ifndef CPROVER_2LS_SOLVER_SUMMARY_CACHE_H
+#define CPROVER_2LS_SOLVER_SUMMARY_CACHE_H
+
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+#include <util/message.h>
+#include <util/options.h>
+
+#include <ssa/ssa_db.h>
+
+#include "summary_db.h"
+
+class summary_cachet:public messaget
+{
+public:
+  typedef irep_idt function_namet;
+  typedef unsigned long long keyt;
+
+  summary_cachet(
+    const optionst &_options,
+    ssa_dbt &_ssa_db,
+    summary_dbt &_summary_db,
+    const std::string &_directory):
+    options(_options),
+    ssa_db(_ssa_db),
+    summary_db(_summary_db),
+    directory(_directory),
+    hits(0),
+    misses(0)
+  {
+  }
+
+  // loads the summaries that the given analysis phase would compute
+  void load(bool forward, bool termination);
+
+  // stores the summaries that could not be loaded
+  void store();
+
+  unsigned get_number_of_hits() { return hits; }
+  unsigned get_number_of_misses() { return misses; }
+
+protected:
+  const optionst &options;
+  ssa_dbt &ssa_db;
+  summary_dbt &summary_db;
+  std::string directory;
+
+  typedef std::map<function_namet, keyt> keyst;
+  keyst keys;
+  std::set<function_namet> missed;
+
+  unsigned hits;
+  unsigned misses;
+
+  void compute_keys(bool forward, bool termination);
+  keyt options_key(bool forward, bool termination);
+  keyt ssa_key(const local_SSAt &SSA);
+
+  // hashes of the ireps of the SSAs by the address of their data
+  typedef std::unordered_map<const void *, keyt> irep_hashest;
+  irep_hashest irep_hashes;
+  keyt hash_irep(const irept &irep);
+
+  std::string file_name(keyt key);
+  bool read(const function_namet &function_name, keyt key);
+  void write(const function_namet &function_name, keyt key);
+};
+
+#endif
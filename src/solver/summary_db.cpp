@@ -37,6 +37,25 @@ void summary_dbt::put(
 
 /*******************************************************************\
 
+Function: summary_dbt::mark_recompute
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void summary_dbt::mark_recompute(const function_namet &function_name)
+{
+  std::map<function_namet, summaryt>::iterator it=store.find(function_name);
+  if(it!=store.end())
+    it->second.mark_recompute=true;
+}
+
+/*******************************************************************\
+
 Function: summary_dbt::mark_recompute_all
 
   Inputs:
@@ -12,6 +12,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "summary.h"
 #include <util/message.h>
 #include <util/json.h>
+#include <domains/ssa_analyzer.h>
 
 class summary_dbt:public messaget
 {
@@ -21,20 +22,40 @@ public:
   // retrieve a summary for function with given identifier
   void read(const std::string &);
   void write();
-  void clear() { store.clear(); }
+  void clear()
+  {
+    store.clear();
+    fixpoints.clear();
+  }
 
   summaryt get(const function_namet &function_name) const
     { return store.at(function_name); }
   bool exists(const function_namet &function_name) const
     { return store.find(function_name)!=store.end(); }
   void put(const function_namet &function_name, const summaryt &summary);
+  void set(const function_namet &function_name, const summaryt &summary)
+    { store[function_name]=summary; }
 
+  void mark_recompute(const function_namet &function_name);
   void mark_recompute_all();
 
+  // the raw results of the last analyses of functions, used to
+  //  warm-start their analysis after further unwinding
+  typedef ssa_analyzert::fixpointt fixpointt;
+  bool has_fixpoint(const function_namet &function_name) const
+    { return fixpoints.find(function_name)!=fixpoints.end(); }
+  const fixpointt &get_fixpoint(const function_namet &function_name) const
+    { return fixpoints.at(function_name); }
+  void set_fixpoint(
+    const function_namet &function_name,
+    const fixpointt &fixpoint)
+    { fixpoints[function_name]=fixpoint; }
+
   jsont summary;
 
 protected:
   std::map<function_namet, summaryt> store;
+  std::map<function_namet, fixpointt> fixpoints;
 
   std::string current;
   std::string file_name(const std::string &);
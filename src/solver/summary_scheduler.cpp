@@ -0,0 +1,186 @@
+/*******************************************************************\
+
+Module: Bottom-up Scheduling of Function Summarization
+
+Author: Peter Schrammel
+
+\*******************************************************************/
+
+#include <algorithm>
+
+#include "summary_scheduler.h"
+
+/*******************************************************************\
+
+Function: summary_schedulert::operator()
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void summary_schedulert::operator()()
+{
+  build_call_graph();
+  compute_sccs();
+  compute_levels();
+}
+
+/*******************************************************************\
+
+Function: summary_schedulert::build_call_graph
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: collects the calls to functions with SSA from the SSA nodes
+
+\*******************************************************************/
+
+void summary_schedulert::build_call_graph()
+{
+  call_graph.clear();
+  for(const auto &f : ssa_db.functions())
+  {
+    std::set<function_namet> &callees=call_graph[f.first];
+    for(const auto &node : f.second->nodes)
+    {
+      for(const auto &call : node.function_calls)
+      {
+        assert(call.function().id()==ID_symbol); // no function pointers
+        irep_idt fname=to_symbol_expr(call.function()).get_identifier();
+        if(ssa_db.exists(fname))
+          callees.insert(fname);
+      }
+    }
+  }
+}
+
+/*******************************************************************\
+
+Function: summary_schedulert::compute_sccs
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void summary_schedulert::compute_sccs()
+{
+  sccs.clear();
+  scc_of.clear();
+  tarjan_map.clear();
+  tarjan_stack.clear();
+  tarjan_index=0;
+
+  for(const auto &f : call_graph)
+  {
+    if(tarjan_map.find(f.first)==tarjan_map.end())
+      strong_connect(f.first);
+  }
+}
+
+/*******************************************************************\
+
+Function: summary_schedulert::strong_connect
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: emits SCCs in reverse topological order,
+          i.e. all callees before their callers
+
+\*******************************************************************/
+
+void summary_schedulert::strong_connect(const function_namet &function_name)
+{
+  tarjan_infot &info=tarjan_map[function_name];
+  info.index=tarjan_index;
+  info.lowlink=tarjan_index;
+  info.on_stack=true;
+  tarjan_index++;
+  tarjan_stack.push_back(function_name);
+
+  for(const auto &callee : call_graph[function_name])
+  {
+    tarjan_mapt::iterator c_it=tarjan_map.find(callee);
+    if(c_it==tarjan_map.end())
+    {
+      strong_connect(callee);
+      tarjan_infot &f_info=tarjan_map[function_name];
+      f_info.lowlink=std::min(f_info.lowlink, tarjan_map[callee].lowlink);
+    }
+    else if(c_it->second.on_stack)
+    {
+      tarjan_infot &f_info=tarjan_map[function_name];
+      f_info.lowlink=std::min(f_info.lowlink, c_it->second.index);
+    }
+  }
+
+  const tarjan_infot &f_info=tarjan_map[function_name];
+  if(f_info.lowlink!=f_info.index)
+    return;
+
+  // function_name is the root of an SCC
+  sccs.push_back(scct());
+  scct &scc=sccs.back();
+  function_namet member;
+  do
+  {
+    member=tarjan_stack.back();
+    tarjan_stack.pop_back();
+    tarjan_map[member].on_stack=false;
+    scc.push_back(member);
+    scc_of[member]=sccs.size()-1;
+  }
+  while(member!=function_name);
+
+  // keep the order of the sequential summarizer within an SCC
+  std::sort(scc.begin(), scc.end());
+}
+
+/*******************************************************************\
+
+Function: summary_schedulert::compute_levels
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: level of an SCC is one more than the maximum level
+          of the SCCs it calls
+
+\*******************************************************************/
+
+void summary_schedulert::compute_levels()
+{
+  levels.clear();
+  std::vector<std::size_t> scc_level(sccs.size(), 0);
+
+  // SCCs are in bottom-up order, hence callee levels are known
+  for(std::size_t i=0; i<sccs.size(); ++i)
+  {
+    std::size_t level=0;
+    for(const auto &f : sccs[i])
+    {
+      for(const auto &callee : call_graph[f])
+      {
+        std::size_t callee_scc=scc_of[callee];
+        if(callee_scc!=i)
+          level=std::max(level, scc_level[callee_scc]+1);
+      }
+    }
+    scc_level[i]=level;
+    if(levels.size()<=level)
+      levels.resize(level+1);
+    levels[level].push_back(i);
+  }
+}
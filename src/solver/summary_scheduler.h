@@ -0,0 +1,69 @@
+/*******************************************************************\
+
+Module: Bottom-up Scheduling of Function Summarization
+
+Author: Peter Schrammel
+
+\*******************************************************************/
+
+#ifndef CPROVER_2LS_SOLVER_SUMMARY_SCHEDULER_H
+#define CPROVER_2LS_SOLVER_SUMMARY_SCHEDULER_H
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include <ssa/ssa_db.h>
+
+class summary_schedulert
+{
+public:
+  typedef irep_idt function_namet;
+  typedef std::vector<function_namet> scct;
+  typedef std::vector<std::size_t> levelt;
+  typedef std::map<function_namet, std::set<function_namet> > call_grapht;
+
+  explicit summary_schedulert(ssa_dbt &_ssa_db):
+    ssa_db(_ssa_db)
+  {
+  }
+
+  // builds the call graph and condenses it into SCCs
+  void operator()();
+
+  // strongly connected components of the call graph,
+  //  callees come before their callers
+  std::vector<scct> sccs;
+
+  // the SCCs in a level only call functions in SCCs of lower levels,
+  //  hence, the SCCs of a level can be summarized independently
+  std::vector<levelt> levels;
+
+  const call_grapht &get_call_graph() const { return call_graph; }
+
+protected:
+  ssa_dbt &ssa_db;
+
+  call_grapht call_graph;
+
+  void build_call_graph();
+  void compute_sccs();
+  void compute_levels();
+
+  // Tarjan's algorithm
+  struct tarjan_infot
+  {
+    std::size_t index;
+    std::size_t lowlink;
+    bool on_stack;
+  };
+  typedef std::map<function_namet, tarjan_infot> tarjan_mapt;
+  std::size_t tarjan_index;
+  tarjan_mapt tarjan_map;
+  std::vector<function_namet> tarjan_stack;
+  std::map<function_namet, std::size_t> scc_of;
+
+  void strong_connect(const function_namet &function_name);
+};
+
+#endif
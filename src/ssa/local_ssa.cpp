@@ -214,25 +214,98 @@ void local_SSAt::collect_custom_templates()
 
 /*******************************************************************\
 
-Function: local_SSAt::find_node
+Function: local_SSAt::build_node_index
 
   Inputs:
 
  Outputs:
 
+ Purpose: indexes the nodes by the location number; the index is
+          rebuilt lazily whenever it has been invalidated or the
+          number of nodes has changed (unwinding, inlining)
+
+\*******************************************************************/
+
+void local_SSAt::build_node_index() const
+{
+  node_index.locations.clear();
+  node_index.locations.resize(location_map.size());
+  node_index.foreign.clear();
+
+  // the index hands out non-const iterators for the non-const find_node
+  nodest &_nodes=const_cast<nodest &>(nodes);
+  for(nodest::iterator n_it=_nodes.begin(); n_it!=_nodes.end(); n_it++)
+  {
+    unsigned location_number=n_it->location->location_number;
+    if(location_number>=location_offset &&
+       location_number-location_offset<node_index.locations.size() &&
+       location_map[location_number-location_offset]==n_it->location)
+      node_index.locations[location_number-location_offset].push_back(n_it);
+    else
+      node_index.foreign[location_number].push_back(n_it);
+  }
+
+  node_index.size=nodes.size();
+  node_index.valid=true;
+}
+
+/*******************************************************************\
+
+Function: local_SSAt::lookup_node_index
+
+  Inputs:
+
+ Outputs: the nodes for the given location, NULL if there are none
+
  Purpose:
 
 \*******************************************************************/
 
-local_SSAt::nodest::iterator local_SSAt::find_node(locationt loc)
+const local_SSAt::node_iteratorst *local_SSAt::lookup_node_index(
+  locationt loc) const
 {
-  nodest::iterator n_it=nodes.begin();
-  for(; n_it!=nodes.end(); n_it++)
+  if(!node_index.valid || node_index.size!=nodes.size())
+    build_node_index();
+
+  const node_iteratorst *result=NULL;
+  unsigned location_number=loc->location_number;
+  if(location_number>=location_offset &&
+     location_number-location_offset<node_index.locations.size() &&
+     location_map[location_number-location_offset]==loc)
   {
-    if(n_it->location==loc)
-      break;
+    result=&node_index.locations[location_number-location_offset];
+  }
+  else
+  {
+    std::map<unsigned, node_iteratorst>::const_iterator it=
+      node_index.foreign.find(location_number);
+    if(it!=node_index.foreign.end())
+      result=&it->second;
   }
-  return n_it;
+
+  if(result==NULL || result->empty())
+    return NULL;
+  return result;
+}
+
+/*******************************************************************\
+
+Function: local_SSAt::find_node
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+local_SSAt::nodest::iterator local_SSAt::find_node(locationt loc)
+{
+  const node_iteratorst *n_its=lookup_node_index(loc);
+  if(n_its==NULL)
+    return nodes.end();
+  return n_its->front();
 }
 
 /*******************************************************************\
@@ -249,13 +322,10 @@ Function: local_SSAt::find_node
 
 local_SSAt::nodest::const_iterator local_SSAt::find_node(locationt loc) const
 {
-  nodest::const_iterator n_it=nodes.begin();
-  for(; n_it!=nodes.end(); n_it++)
-  {
-    if(n_it->location==loc)
-      break;
-  }
-  return n_it;
+  const node_iteratorst *n_its=lookup_node_index(loc);
+  if(n_its==NULL)
+    return nodes.end();
+  return n_its->front();
 }
 
 /*******************************************************************\
@@ -274,12 +344,11 @@ void local_SSAt::find_nodes(
   locationt loc,
   std::list<nodest::const_iterator> &_nodes) const
 {
-  nodest::const_iterator n_it=nodes.begin();
-  for(; n_it!=nodes.end(); n_it++)
-  {
-    if(n_it->location==loc)
-      _nodes.push_back(n_it);
-  }
+  const node_iteratorst *n_its=lookup_node_index(loc);
+  if(n_its==NULL)
+    return;
+  for(const auto &n_it : *n_its)
+    _nodes.push_back(n_it);
 }
 
 /*******************************************************************\
@@ -781,6 +850,40 @@ void local_SSAt::assertions_to_constraints()
 
 /*******************************************************************\
 
+Function: local_SSAt::share_expressions
+
+  Inputs: store of the expressions merged so far
+
+ Outputs:
+
+ Purpose: the nodes of unwound loops, guards and types contain many
+          identical subexpressions; after merging, these are shared
+          and hence stored once; marked nodes have been merged
+          before they were given to the solver
+
+\*******************************************************************/
+
+void local_SSAt::share_expressions(merge_full_irept &merge_irep)
+{
+  for(auto &node : nodes)
+  {
+    if(node.marked)
+      continue;
+
+    for(auto &e : node.equalities)
+      merge_irep(e);
+    for(auto &c : node.constraints)
+      merge_irep(c);
+    for(auto &a : node.assertions)
+      merge_irep(a);
+    for(auto &f : node.function_calls)
+      merge_irep(f);
+    merge_irep(node.enabling_expr);
+  }
+}
+
+/*******************************************************************\
+
 Function: local_SSAt::cond_symbol
 
   Inputs:
@@ -10,6 +10,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_2LS_SSA_LOCAL_SSA_H
 
 #include <util/std_expr.h>
+#include <util/merge_irep.h>
 
 #include <goto-programs/goto_functions.h>
 
@@ -47,11 +48,22 @@ public:
     alias_analysis(_goto_function, ns),
     guard_map(_goto_function.body),
     ssa_analysis(assignments),
-    suffix(_suffix)
+    suffix(_suffix),
+    location_offset(0)
   {
     // ENHANCE: in future locst will be used (currently in path-symex/locs.h)
+    // location numbers are consecutive within a function body
+    if(!_goto_function.body.instructions.empty())
+      location_offset=
+        _goto_function.body.instructions.front().location_number;
     forall_goto_program_instructions(it, _goto_function.body)
-      location_map[it->location_number]=it;
+    {
+      assert(it->location_number>=location_offset);
+      unsigned index=it->location_number-location_offset;
+      if(index>=location_map.size())
+        location_map.resize(index+1, it);
+      location_map[index]=it;
+    }
 
     build_SSA();
   }
@@ -110,6 +122,9 @@ public:
   // turns the assertions in the function into constraints
   void assertions_to_constraints();
 
+  // stores identical subexpressions of the unmarked nodes only once
+  void share_expressions(merge_full_irept &merge_irep);
+
   // all the SSA nodes
   typedef std::list<nodet> nodest;
   nodest nodes;
@@ -266,16 +281,55 @@ public:
     locationt loc,
     std::list<nodest::const_iterator> &_nodes) const;
 
+  // must be called after nodes have been added or removed
+  inline void invalidate_node_index()
+  {
+    node_index.valid=false;
+  }
+
   inline locationt get_location(unsigned location_number) const
   {
-    location_mapt::const_iterator it=location_map.find(location_number);
-    assert(it!=location_map.end());
-    return it->second;
+    assert(location_number>=location_offset);
+    assert(location_number-location_offset<location_map.size());
+    return location_map[location_number-location_offset];
   }
 
 protected:
-  typedef std::map<unsigned, locationt> location_mapt;
+  typedef std::vector<locationt> location_mapt;
   location_mapt location_map;
+  unsigned location_offset;
+
+  // nodes by location number, in the order of the node list;
+  //  nodes with locations of other functions (from inlining)
+  //  are kept in a separate map
+  typedef std::vector<nodest::iterator> node_iteratorst;
+  class node_indext
+  {
+  public:
+    node_indext():size(0), valid(false) {}
+
+    // the iterators point into the nodes of the copied SSA,
+    //  hence, a copy starts without an index
+    node_indext(const node_indext &):size(0), valid(false) {}
+    node_indext &operator=(const node_indext &)
+    {
+      locations.clear();
+      foreign.clear();
+      size=0;
+      valid=false;
+      return *this;
+    }
+
+    std::vector<node_iteratorst> locations;
+    std::map<unsigned, node_iteratorst> foreign;
+    std::size_t size;
+    bool valid;
+  };
+  mutable node_indext node_index;
+
+  void build_node_index() const;
+  const node_iteratorst *lookup_node_index(locationt loc) const;
+
   // build the SSA formulas
   void build_SSA();
 
@@ -0,0 +1,199 @@
+/*******************************************************************\
+
+Module: Map with Copy-on-write Sharing of Buckets
+
+Author: Peter Schrammel
+
+\*******************************************************************/
+
+#ifndef CPROVER_2LS_SSA_SHARED_MAP_H
+#define CPROVER_2LS_SSA_SHARED_MAP_H
+
+#include <cassert>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <util/irep.h>
+
+// A map whose entries are distributed over a fixed number of buckets
+//  by their hash. The buckets are shared between copies of the map
+//  and only copied when they are modified. Copying the map hence
+//  costs a constant number of pointer copies, and a modification
+//  duplicates a single bucket only.
+// The iteration order is by bucket, and within a bucket by key.
+
+template<class keyT, class dataT, class hashT=irep_id_hash>
+class shared_mapt
+{
+public:
+  typedef keyT key_type;
+  typedef dataT mapped_type;
+  typedef std::map<keyT, dataT> bucket_mapt;
+  typedef typename bucket_mapt::value_type value_type;
+
+  static const std::size_t bucket_count=32;
+
+  shared_mapt():
+    number_of_entries(0)
+  {
+  }
+
+  class const_iterator
+  {
+  public:
+    const_iterator():
+      map(NULL),
+      bucket(0)
+    {
+    }
+
+    const value_type &operator*() const { return *it; }
+    const value_type *operator->() const { return &(*it); }
+
+    const_iterator &operator++()
+    {
+      ++it;
+      skip_empty();
+      return *this;
+    }
+
+    const_iterator operator++(int)
+    {
+      const_iterator tmp=*this;
+      ++(*this);
+      return tmp;
+    }
+
+    bool operator==(const const_iterator &other) const
+    {
+      return bucket==other.bucket &&
+             (bucket==bucket_count || it==other.it);
+    }
+
+    bool operator!=(const const_iterator &other) const
+    {
+      return !(*this==other);
+    }
+
+  protected:
+    friend class shared_mapt;
+
+    const shared_mapt *map;
+    std::size_t bucket;
+    typename bucket_mapt::const_iterator it;
+
+    // move to the next entry if the current bucket is exhausted
+    void skip_empty()
+    {
+      while(bucket<bucket_count &&
+            it==map->buckets[bucket]->end())
+      {
+        bucket++;
+        while(bucket<bucket_count && !map->buckets[bucket])
+          bucket++;
+        if(bucket<bucket_count)
+          it=map->buckets[bucket]->begin();
+      }
+    }
+  };
+
+  typedef const_iterator iterator;
+
+  const_iterator begin() const
+  {
+    const_iterator result;
+    result.map=this;
+    result.bucket=0;
+    while(result.bucket<bucket_count &&
+          (buckets.empty() || !buckets[result.bucket]))
+      result.bucket++;
+    if(result.bucket<bucket_count)
+    {
+      result.it=buckets[result.bucket]->begin();
+      result.skip_empty();
+    }
+    return result;
+  }
+
+  const_iterator end() const
+  {
+    const_iterator result;
+    result.map=this;
+    result.bucket=bucket_count;
+    return result;
+  }
+
+  const_iterator find(const keyT &key) const
+  {
+    if(buckets.empty())
+      return end();
+    std::size_t b=bucket_of(key);
+    if(!buckets[b])
+      return end();
+    typename bucket_mapt::const_iterator it=buckets[b]->find(key);
+    if(it==buckets[b]->end())
+      return end();
+    const_iterator result;
+    result.map=this;
+    result.bucket=b;
+    result.it=it;
+    return result;
+  }
+
+  // the bucket of the key is unshared before it is returned
+  dataT &operator[](const keyT &key)
+  {
+    bucket_mapt &bucket=get_writeable(bucket_of(key));
+    std::size_t size=bucket.size();
+    dataT &result=bucket[key];
+    number_of_entries+=bucket.size()-size;
+    return result;
+  }
+
+  std::size_t erase(const keyT &key)
+  {
+    if(find(key)==end())
+      return 0;
+    get_writeable(bucket_of(key)).erase(key);
+    number_of_entries--;
+    return 1;
+  }
+
+  void clear()
+  {
+    buckets.clear();
+    number_of_entries=0;
+  }
+
+  std::size_t size() const { return number_of_entries; }
+  bool empty() const { return number_of_entries==0; }
+
+protected:
+  typedef std::shared_ptr<bucket_mapt> bucket_ptrt;
+  std::vector<bucket_ptrt> buckets;
+  std::size_t number_of_entries;
+
+  static std::size_t bucket_of(const keyT &key)
+  {
+    return hashT()(key)%bucket_count;
+  }
+
+  bucket_mapt &get_writeable(std::size_t b)
+  {
+    if(buckets.empty())
+      buckets.resize(bucket_count);
+    bucket_ptrt &bucket=buckets[b];
+    if(!bucket)
+      bucket=std::make_shared<bucket_mapt>();
+    else if(bucket.use_count()>1)
+      bucket=std::make_shared<bucket_mapt>(*bucket);
+    assert(bucket.use_count()==1);
+    return *bucket;
+  }
+};
+
+template<class keyT, class dataT, class hashT>
+const std::size_t shared_mapt<keyT, dataT, hashT>::bucket_count;
+
+#endif
@@ -9,6 +9,8 @@ Author: Peter Schrammel
 #ifndef CPROVER_2LS_SSA_SSA_DB_H
 #define CPROVER_2LS_SSA_SSA_DB_H
 
+#include <set>
+
 #include <util/options.h>
 
 #include <ssa/unwindable_local_ssa.h>
@@ -46,11 +48,14 @@ public:
     if(it!=the_solvers.end())
       return *(it->second);
 
-    the_solvers[function_name]=
+    incremental_solvert *solver=
       incremental_solvert::allocate(
         store.at(function_name)->ns,
         options.get_bool_option("refine"));
-    return *the_solvers.at(function_name);
+    solver->set_compaction_threshold(
+      options.get_unsigned_int_option("solver-compaction"));
+    the_solvers[function_name]=solver;
+    return *solver;
   }
 
   inline functionst &functions() { return store; }
@@ -71,6 +76,16 @@ public:
       new unwindable_local_SSAt(goto_function, ns, heap_analysis);
   }
 
+  // shares identical subexpressions of the SSAs of the given
+  //  functions; the store is dropped afterwards such that it does
+  //  not keep expressions alive that are replaced later
+  inline void share_expressions(const std::set<function_namet> &functions)
+  {
+    merge_full_irept merge_irep;
+    for(const auto &f : functions)
+      store.at(f)->share_expressions(merge_irep);
+  }
+
 protected:
   const optionst &options;
   functionst store;
@@ -38,7 +38,8 @@ void ssa_domaint::output(
       d_it!=def_map.end();
       d_it++)
   {
-    out << "DEF " << d_it->first << ": " << d_it->second << "\n";
+    out << "DEF " << d_it->first << ": " << d_it->second.def
+        << " from " << get_source(d_it->second)->location_number << "\n";
   }
 
   for(phi_nodest::const_iterator
@@ -137,9 +138,39 @@ void ssa_domaint::transform(
   }
 
   // update source in all defs
-  for(def_mapt::iterator
+  common_source=from;
+  common_source_valid=true;
+}
+
+/*******************************************************************\
+
+Function: ssa_domaint::set_sources
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: stores the common source in the entries whose source
+          differs from it
+
+\*******************************************************************/
+
+void ssa_domaint::set_sources()
+{
+  if(!common_source_valid)
+    return;
+
+  std::vector<irep_idt> ids;
+  for(def_mapt::const_iterator
       d_it=def_map.begin(); d_it!=def_map.end(); d_it++)
-    d_it->second.source=from;
+  {
+    if(d_it->second.source!=common_source)
+      ids.push_back(d_it->first);
+  }
+  for(const auto &id : ids)
+    def_map[id].source=common_source;
+
+  common_source_valid=false;
 }
 
 /*******************************************************************\
@@ -159,6 +190,22 @@ bool ssa_domaint::merge(
   locationt from,
   locationt to)
 {
+  // not reached so far: share the definitions of b
+  if(def_map.empty() && phi_nodes.empty())
+  {
+    def_map=b.def_map;
+    common_source_valid=b.common_source_valid;
+    common_source=b.common_source;
+
+    #ifdef DEBUG
+    std::cout << "SETTING " << def_map.size() << " definitions\n";
+    #endif
+
+    return !def_map.empty();
+  }
+
+  set_sources();
+
   bool result=false;
 
   // should traverse both maps simultaneously
@@ -168,25 +215,28 @@ bool ssa_domaint::merge(
       d_it_b++)
   {
     const irep_idt &id=d_it_b->first;
+    const deft &def_b=d_it_b->second.def;
+    locationt source_b=b.get_source(d_it_b->second);
 
     // check if we have a phi node for 'id'
 
-    phi_nodest::iterator p_it=phi_nodes.find(id);
-    if(p_it!=phi_nodes.end())
+    if(phi_nodes.find(id)!=phi_nodes.end())
     {
       // yes, simply add to existing phi node
-      loc_def_mapt &phi_node=p_it->second;
-      phi_node[d_it_b->second.source->location_number]=d_it_b->second.def;
+      loc_def_mapt &phi_node=phi_nodes[id];
+      phi_node[source_b->location_number]=def_b;
       // doesn't get propagated, don't set result to 'true'
       continue;
     }
 
     // have we seen this variable yet?
-    def_mapt::iterator d_it_a=def_map.find(id);
+    def_mapt::const_iterator d_it_a=def_map.find(id);
     if(d_it_a==def_map.end())
     {
       // no entry in 'this' yet, simply create a new entry
-      def_map[id]=d_it_b->second;
+      def_entryt &def_entry=def_map[id];
+      def_entry.def=def_b;
+      def_entry.source=source_b;
       result=true;
 
       #ifdef DEBUG
@@ -196,19 +246,19 @@ bool ssa_domaint::merge(
     }
 
     // we have two entries, compare
-    if(d_it_a->second.def==d_it_b->second.def)
+    if(d_it_a->second.def==def_b)
     {
       #ifdef DEBUG
-      std::cout << "AGREE " << id << ": " << d_it_b->second << "\n";
+      std::cout << "AGREE " << id << ": " << def_b << "\n";
       #endif
       continue;
     }
 
     // Different definitions. Are they coming from the same source?
-    if(d_it_a->second.source==d_it_b->second.source)
+    if(d_it_a->second.source==source_b)
     {
       // Propagate the new definition for same source.
-      d_it_a->second.def=d_it_b->second.def;
+      def_map[id].def=def_b;
       result=true;
 
       #ifdef DEBUG
@@ -222,17 +272,18 @@ bool ssa_domaint::merge(
       loc_def_mapt &phi_node=phi_nodes[id];
 
       phi_node[d_it_a->second.source->location_number]=d_it_a->second.def;
-      phi_node[d_it_b->second.source->location_number]=d_it_b->second.def;
+      phi_node[source_b->location_number]=def_b;
 
       // This phi node is now the new source.
-      d_it_a->second.def.loc=to;
-      d_it_a->second.def.kind=deft::PHI;
-      d_it_a->second.source=to;
+      def_entryt &def_entry=def_map[id];
+      def_entry.def.loc=to;
+      def_entry.def.kind=deft::PHI;
+      def_entry.source=to;
 
       result=true;
 
       #ifdef DEBUG
-      std::cout << "MERGING " << id << ": " << d_it_b->second << "\n";
+      std::cout << "MERGING " << id << ": " << def_b << "\n";
       #endif
     }
   }
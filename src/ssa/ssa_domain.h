@@ -12,10 +12,16 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <analyses/ai.h>
 
 #include "assignments.h"
+#include "shared_map.h"
 
 class ssa_domaint:public ai_domain_baset
 {
 public:
+  ssa_domaint():
+    common_source_valid(false)
+  {
+  }
+
   // sources for identifiers
   struct deft
   {
@@ -62,15 +68,23 @@ public:
     return out << d.def << " from " << d.source->location_number;
   }
 
-  typedef std::map<irep_idt, def_entryt> def_mapt;
+  // The maps are shared between the domains of the locations
+  // and only the modified parts are copied.
+  typedef shared_mapt<irep_idt, def_entryt> def_mapt;
   def_mapt def_map;
 
   // The phi nodes map identifiers to incoming branches:
   // map from source to definition.
   typedef std::map<unsigned, deft> loc_def_mapt;
-  typedef std::map<irep_idt, loc_def_mapt> phi_nodest;
+  typedef shared_mapt<irep_idt, loc_def_mapt> phi_nodest;
   phi_nodest phi_nodes;
 
+  // the source of a definition
+  inline locationt get_source(const def_entryt &entry) const
+  {
+    return common_source_valid ? common_source : entry.source;
+  }
+
   virtual void transform(
     locationt from,
     locationt to,
@@ -88,8 +102,15 @@ public:
     locationt to);
 
 private:
-  static std::map<dstring, ssa_domaint::def_entryt>::const_iterator
-  get_object_allocation_def(
+  // After a transformation all definitions come from the same
+  // source, which is stored here instead of in each entry
+  // such that the unmodified entries remain shared.
+  bool common_source_valid;
+  locationt common_source;
+
+  void set_sources();
+
+  static def_mapt::const_iterator get_object_allocation_def(
     const irep_idt &id,
     const def_mapt &def_map);
 };
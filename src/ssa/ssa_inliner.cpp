@@ -11,6 +11,8 @@ Author: Peter Schrammel
 #include <util/i2string.h>
 #include <util/replace_expr.h>
 
+#include <domains/util.h>
+
 #include "ssa_inliner.h"
 
 /*******************************************************************\
@@ -256,7 +258,8 @@ void ssa_inlinert::replace(
         debug() << "No summary available for function " << fname << eom;
       commit_node(n_it);
     }
-    commit_nodes(SSA.nodes, n_it);
+    if(!commit_nodes(SSA.nodes, n_it))
+      SSA.invalidate_node_index();
   }
 }
 
@@ -315,8 +318,11 @@ void ssa_inlinert::replace(
           for(local_SSAt::nodest::const_iterator fn_it=fSSA.nodes.begin();
               fn_it!=fSSA.nodes.end(); fn_it++)
           {
-            debug() << "new node: "; fn_it->output(debug(), fSSA.ns);
-            debug() << eom;
+            if(message_enabled(*this, M_DEBUG))
+            {
+              debug() << "new node: "; fn_it->output(debug(), fSSA.ns);
+              debug() << eom;
+            }
 
             new_nodes.push_back(*fn_it);
           }
@@ -326,7 +332,8 @@ void ssa_inlinert::replace(
         debug() << "No body available for function " << fname << eom;
       commit_node(n_it);
     }
-    commit_nodes(SSA.nodes, n_it);
+    if(!commit_nodes(SSA.nodes, n_it))
+      SSA.invalidate_node_index();
   }
 }
 
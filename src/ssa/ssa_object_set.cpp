@@ -0,0 +1,301 @@
+/*******************************************************************\
+
+Module: Sets of SSA Objects as Sparse Bitsets
+
+Author: Peter Schrammel
+
+\*******************************************************************/
+
+#include <algorithm>
+#include <cassert>
+
+#include "ssa_object_set.h"
+
+const unsigned ssa_object_sett::word_bits;
+ssa_object_sett::object_tablet ssa_object_sett::object_table;
+
+/*******************************************************************\
+
+Function: ssa_object_sett::const_iterator::skip_unset
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void ssa_object_sett::const_iterator::skip_unset()
+{
+  while(word<set->words.size())
+  {
+    if(bit<word_bits)
+    {
+      wordt w=set->words[word].second>>bit;
+      if(w!=0)
+      {
+        for(; (w&1)==0; w>>=1)
+          bit++;
+        return;
+      }
+    }
+    word++;
+    bit=0;
+  }
+  bit=0;
+}
+
+/*******************************************************************\
+
+Function: ssa_object_sett::begin
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+ssa_object_sett::const_iterator ssa_object_sett::begin() const
+{
+  const_iterator result;
+  result.set=this;
+  result.word=0;
+  result.bit=0;
+  result.skip_unset();
+  return result;
+}
+
+/*******************************************************************\
+
+Function: ssa_object_sett::end
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+ssa_object_sett::const_iterator ssa_object_sett::end() const
+{
+  const_iterator result;
+  result.set=this;
+  result.word=words.size();
+  result.bit=0;
+  return result;
+}
+
+/*******************************************************************\
+
+Function: ssa_object_sett::get_object
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+const ssa_objectt &ssa_object_sett::get_object(unsigned index) const
+{
+  variantst::const_iterator v_it=variants.find(index);
+  if(v_it!=variants.end())
+    return v_it->second;
+
+  object_tablet::const_iterator o_it=object_table.find(index);
+  assert(o_it!=object_table.end());
+  return o_it->second;
+}
+
+/*******************************************************************\
+
+Function: ssa_object_sett::make_iterator
+
+  Inputs: index of an object in the set
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+ssa_object_sett::const_iterator ssa_object_sett::make_iterator(
+  unsigned index) const
+{
+  const_iterator result;
+  result.set=this;
+  result.word=std::lower_bound(
+    words.begin(),
+    words.end(),
+    std::make_pair(index/word_bits, wordt(0)))-words.begin();
+  result.bit=index%word_bits;
+  return result;
+}
+
+/*******************************************************************\
+
+Function: ssa_object_sett::find_word
+
+  Inputs:
+
+ Outputs: the word with the given index, which is created if needed
+
+ Purpose:
+
+\*******************************************************************/
+
+ssa_object_sett::wordst::iterator ssa_object_sett::find_word(
+  unsigned word_index)
+{
+  wordst::iterator w_it=std::lower_bound(
+    words.begin(),
+    words.end(),
+    std::make_pair(word_index, wordt(0)));
+  if(w_it==words.end() || w_it->first!=word_index)
+    w_it=words.insert(w_it, std::make_pair(word_index, wordt(0)));
+  return w_it;
+}
+
+/*******************************************************************\
+
+Function: ssa_object_sett::add_object
+
+  Inputs: index of an object that is newly added to the set
+
+ Outputs:
+
+ Purpose: stores the object in the table, or as a variant
+          if the table has a different expression for it
+
+\*******************************************************************/
+
+void ssa_object_sett::add_object(unsigned index, const ssa_objectt &object)
+{
+  std::pair<object_tablet::iterator, bool> entry=
+    object_table.insert(std::make_pair(index, object));
+  if(!entry.second && !(entry.first->second.get_expr()==object.get_expr()))
+    variants.insert(std::make_pair(index, object));
+
+  number_of_objects++;
+  if(object.get_expr().get_bool(ID_iterator))
+    number_of_iterators++;
+}
+
+/*******************************************************************\
+
+Function: ssa_object_sett::insert
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::pair<ssa_object_sett::const_iterator, bool> ssa_object_sett::insert(
+  const ssa_objectt &object)
+{
+  unsigned index=object.get_identifier().get_no();
+  wordst::iterator w_it=find_word(index/word_bits);
+  wordt mask=wordt(1)<<(index%word_bits);
+
+  if((w_it->second&mask)!=0)
+    return std::make_pair(make_iterator(index), false);
+
+  w_it->second|=mask;
+  add_object(index, object);
+  return std::make_pair(make_iterator(index), true);
+}
+
+/*******************************************************************\
+
+Function: ssa_object_sett::insert
+
+  Inputs:
+
+ Outputs: returns true if this set has changed
+
+ Purpose: word-wise union; objects already in this set are kept
+
+\*******************************************************************/
+
+bool ssa_object_sett::insert(const ssa_object_sett &src)
+{
+  if(src.empty())
+    return false;
+
+  wordst result;
+  result.reserve(words.size()+src.words.size());
+
+  bool changed=false;
+  wordst::const_iterator a_it=words.begin();
+  wordst::const_iterator b_it=src.words.begin();
+  while(a_it!=words.end() || b_it!=src.words.end())
+  {
+    if(b_it==src.words.end() ||
+       (a_it!=words.end() && a_it->first<b_it->first))
+    {
+      result.push_back(*a_it++);
+      continue;
+    }
+
+    wordt old_bits=0;
+    if(a_it!=words.end() && a_it->first==b_it->first)
+      old_bits=(a_it++)->second;
+
+    wordt new_bits=b_it->second&~old_bits;
+    if(new_bits!=0)
+    {
+      changed=true;
+      for(unsigned bit=0; bit<word_bits; bit++)
+      {
+        if((new_bits&(wordt(1)<<bit))!=0)
+        {
+          unsigned index=b_it->first*word_bits+bit;
+          add_object(index, src.get_object(index));
+        }
+      }
+    }
+
+    result.push_back(std::make_pair(b_it->first, old_bits|b_it->second));
+    b_it++;
+  }
+
+  if(changed)
+    words.swap(result);
+  return changed;
+}
+
+/*******************************************************************\
+
+Function: ssa_object_sett::erase
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void ssa_object_sett::erase(const_iterator it)
+{
+  assert(it.set==this && it.word<words.size());
+  unsigned index=it.get_index();
+
+  if(it->get_expr().get_bool(ID_iterator))
+    number_of_iterators--;
+  number_of_objects--;
+  variants.erase(index);
+
+  wordst::iterator w_it=words.begin()+it.word;
+  w_it->second&=~(wordt(1)<<it.bit);
+  if(w_it->second==0)
+    words.erase(w_it);
+}
@@ -0,0 +1,157 @@
+/*******************************************************************\
+
+Module: Sets of SSA Objects as Sparse Bitsets
+
+Author: Peter Schrammel
+
+\*******************************************************************/
+
+#ifndef CPROVER_2LS_SSA_SSA_OBJECT_SET_H
+#define CPROVER_2LS_SSA_SSA_OBJECT_SET_H
+
+#include <iterator>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ssa_object.h"
+
+// A set of SSA objects that behaves like std::set<ssa_objectt>.
+// The identifiers of SSA objects are interned strings, hence their
+// numbers are used as indices into a sparse bitset, which also
+// gives the same iteration order as std::set<ssa_objectt>.
+// The objects themselves are kept in a table shared by all sets;
+// a set only stores an object if its expression differs from the
+// one in the table (e.g. for iterators with different initial
+// values).
+
+class ssa_object_sett
+{
+public:
+  typedef unsigned long long wordt;
+  static const unsigned word_bits=64;
+
+  ssa_object_sett():
+    number_of_objects(0),
+    number_of_iterators(0)
+  {
+  }
+
+  class const_iterator
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef ssa_objectt value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const ssa_objectt *pointer;
+    typedef const ssa_objectt &reference;
+
+    const_iterator():
+      set(NULL),
+      word(0),
+      bit(0)
+    {
+    }
+
+    const ssa_objectt &operator*() const
+    {
+      return set->get_object(get_index());
+    }
+
+    const ssa_objectt *operator->() const
+    {
+      return &set->get_object(get_index());
+    }
+
+    const_iterator &operator++()
+    {
+      bit++;
+      skip_unset();
+      return *this;
+    }
+
+    const_iterator operator++(int)
+    {
+      const_iterator tmp=*this;
+      ++(*this);
+      return tmp;
+    }
+
+    bool operator==(const const_iterator &other) const
+    {
+      return word==other.word && bit==other.bit;
+    }
+
+    bool operator!=(const const_iterator &other) const
+    {
+      return !(*this==other);
+    }
+
+  protected:
+    friend class ssa_object_sett;
+
+    const ssa_object_sett *set;
+    std::size_t word;
+    unsigned bit;
+
+    unsigned get_index() const
+    {
+      return set->words[word].first*word_bits+bit;
+    }
+
+    // move to the next bit that is set
+    void skip_unset();
+  };
+
+  typedef const_iterator iterator;
+
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  std::size_t size() const { return number_of_objects; }
+  bool empty() const { return number_of_objects==0; }
+  bool has_iterators() const { return number_of_iterators>0; }
+
+  // as for std::set, an object with the same identifier
+  // as an object in the set is not added
+  std::pair<const_iterator, bool> insert(const ssa_objectt &object);
+
+  // adds all objects of src, returns true if this set has changed
+  bool insert(const ssa_object_sett &src);
+
+  void erase(const_iterator it);
+
+  void clear()
+  {
+    *this=ssa_object_sett();
+  }
+
+  bool operator==(const ssa_object_sett &other) const
+  {
+    return words==other.words;
+  }
+
+protected:
+  // pairs of word index and bits, sorted by the word index
+  typedef std::vector<std::pair<unsigned, wordt> > wordst;
+  wordst words;
+
+  // objects whose expression differs from the one in the table
+  typedef std::map<unsigned, ssa_objectt> variantst;
+  variantst variants;
+
+  std::size_t number_of_objects;
+  std::size_t number_of_iterators;
+
+  const ssa_objectt &get_object(unsigned index) const;
+  const_iterator make_iterator(unsigned index) const;
+  wordst::iterator find_word(unsigned word_index);
+  void add_object(unsigned index, const ssa_objectt &object);
+
+  // the objects by the number of their identifier
+  typedef std::unordered_map<unsigned, ssa_objectt> object_tablet;
+  static object_tablet object_table;
+};
+
+#endif
@@ -0,0 +1,155 @@
+/*******************************************************************\
+
+Module: Cone-of-influence Slicing of Local SSA
+
+Author: Peter Schrammel
+
+\*******************************************************************/
+
+#include <map>
+#include <vector>
+
+#include <util/find_symbols.h>
+
+#include "ssa_slicer.h"
+
+/*******************************************************************\
+
+Function: ssa_slicert::compute_cone
+
+  Inputs: SSA, expressions that will be given to the solver
+
+ Outputs: nodes whose equalities and constraints may influence
+          the seed expressions
+
+ Purpose: the dependencies (data and control) are explicit in the
+          SSA: a node is in the cone if it defines a symbol that is
+          used by the seeds or by a node in the cone; constraints
+          and function calls are always in the cone as they restrict
+          the feasible paths
+
+\*******************************************************************/
+
+void ssa_slicert::compute_cone(
+  const local_SSAt &SSA,
+  const exprt::operandst &seeds,
+  node_sett &cone)
+{
+  typedef std::map<irep_idt, std::vector<const local_SSAt::nodet *> > defst;
+  defst defs;
+
+  std::vector<const local_SSAt::nodet *> node_worklist;
+  for(const auto &node : SSA.nodes)
+  {
+    bool root=!node.constraints.empty() || !node.function_calls.empty();
+    for(const auto &e : node.equalities)
+    {
+      if(e.lhs().id()==ID_symbol)
+        defs[to_symbol_expr(e.lhs()).get_identifier()].push_back(&node);
+      else
+        root=true;
+    }
+    if(root && cone.insert(&node).second)
+      node_worklist.push_back(&node);
+  }
+
+  find_symbols_sett symbols;
+  std::vector<irep_idt> symbol_worklist;
+  for(const auto &seed : seeds)
+  {
+    find_symbols_sett seed_symbols;
+    find_symbols(seed, seed_symbols);
+    for(const auto &s : seed_symbols)
+      if(symbols.insert(s).second)
+        symbol_worklist.push_back(s);
+  }
+
+  while(!node_worklist.empty() || !symbol_worklist.empty())
+  {
+    while(!node_worklist.empty())
+    {
+      const local_SSAt::nodet &node=*node_worklist.back();
+      node_worklist.pop_back();
+
+      find_symbols_sett node_symbols;
+      for(const auto &e : node.equalities)
+        find_symbols(e.rhs(), node_symbols);
+      for(const auto &c : node.constraints)
+        find_symbols(c, node_symbols);
+      for(const auto &f : node.function_calls)
+        find_symbols(f, node_symbols);
+      find_symbols(node.enabling_expr, node_symbols);
+
+      for(const auto &s : node_symbols)
+        if(symbols.insert(s).second)
+          symbol_worklist.push_back(s);
+    }
+
+    while(!symbol_worklist.empty())
+    {
+      irep_idt s=symbol_worklist.back();
+      symbol_worklist.pop_back();
+
+      defst::const_iterator d_it=defs.find(s);
+      if(d_it==defs.end())
+        continue;
+      for(const auto &node : d_it->second)
+        if(cone.insert(node).second)
+          node_worklist.push_back(node);
+    }
+  }
+}
+
+/*******************************************************************\
+
+Function: ssa_slicert::operator()
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void ssa_slicert::operator()(
+  incremental_solvert &solver,
+  local_SSAt &SSA,
+  const exprt::operandst &seeds)
+{
+  node_sett cone;
+  compute_cone(SSA, seeds, cone);
+
+  unsigned total=0, added=0;
+  for(auto &node : SSA.nodes)
+  {
+    if(node.marked)
+      continue;
+    total++;
+    if(cone.find(&node)==cone.end())
+      continue;
+    added++;
+
+    for(const auto &e : node.equalities)
+    {
+      if(!node.enabling_expr.is_true())
+        solver << implies_exprt(node.enabling_expr, e);
+      else
+        solver << e;
+    }
+    for(const auto &c : node.constraints)
+    {
+      if(!node.enabling_expr.is_true())
+        solver << implies_exprt(node.enabling_expr, c);
+      else
+        solver << c;
+    }
+    node.marked=true;
+  }
+
+  debug() << "SSA slicing: " << added << " of " << total
+          << " nodes given to the solver" << eom;
+
+  nodes_total+=total;
+  nodes_added+=added;
+}
@@ -0,0 +1,50 @@
+/*******************************************************************\
+
+Module: Cone-of-influence Slicing of Local SSA
+
+Author: Peter Schrammel
+
+\*******************************************************************/
+
+#ifndef CPROVER_2LS_SSA_SSA_SLICER_H
+#define CPROVER_2LS_SSA_SSA_SLICER_H
+
+#include <set>
+
+#include <util/message.h>
+
+#include <domains/incremental_solver.h>
+
+#include "local_ssa.h"
+
+class ssa_slicert:public messaget
+{
+public:
+  ssa_slicert():
+    nodes_total(0),
+    nodes_added(0)
+  {
+  }
+
+  // gives the unmarked nodes that may influence the seed expressions
+  //  to the solver and marks them; the remaining nodes stay unmarked
+  //  such that they are added once they become relevant
+  void operator()(
+    incremental_solvert &solver,
+    local_SSAt &SSA,
+    const exprt::operandst &seeds);
+
+  // statistics
+  unsigned nodes_total;
+  unsigned nodes_added;
+
+protected:
+  typedef std::set<const local_SSAt::nodet *> node_sett;
+
+  void compute_cone(
+    const local_SSAt &SSA,
+    const exprt::operandst &seeds,
+    node_sett &cone);
+};
+
+#endif
@@ -111,6 +111,7 @@ void ssa_local_unwindert::build_loop_tree()
     else
       --n_it;
   }
+  SSA.invalidate_node_index();
 }
 
 /*******************************************************************\
@@ -275,18 +276,97 @@ Function: ssa_local_unwindert::unwind
 
 \*******************************************************************/
 
-void ssa_local_unwindert::unwind(unsigned k)
+bool ssa_local_unwindert::unwind(unsigned k)
 {
-  if(SSA.current_unwinding>=(long)k)
-    return;
+  for(loop_mapt::iterator it=loops.begin(); it!=loops.end(); ++it)
+  {
+    if(it->second.target_unwinding<(long)k)
+      it->second.target_unwinding=k;
+  }
+  return unwind_loops(k);
+}
+
+/*******************************************************************\
+
+Function: ssa_local_unwindert::unwind
+
+  Inputs: location number of a loop head, unwinding depth
+
+ Outputs:
+
+ Purpose: unwind the given loop up to k starting from previous
+          unwindings; the other loops keep their unwinding depth
+
+\*******************************************************************/
+
+bool ssa_local_unwindert::unwind(unsigned loop_head_location_number, unsigned k)
+{
+  loop_mapt::iterator it=loops.find(loop_head_location_number);
+  assert(it!=loops.end());
+  if(it->second.target_unwinding<(long)k)
+    it->second.target_unwinding=k;
+  return unwind_loops(SSA.current_unwinding);
+}
+
+/*******************************************************************\
+
+Function: ssa_local_unwindert::unwind_further
+
+  Inputs: location numbers of loop heads
+
+ Outputs:
+
+ Purpose: increase the unwinding depth of the given loops by one
+
+\*******************************************************************/
+
+bool ssa_local_unwindert::unwind_further(
+  const std::set<unsigned> &loop_head_location_numbers)
+{
+  for(const auto &l : loop_head_location_numbers)
+  {
+    loop_mapt::iterator it=loops.find(l);
+    if(it!=loops.end())
+      it->second.target_unwinding=it->second.current_unwinding+1;
+  }
+  return unwind_loops(SSA.current_unwinding);
+}
+
+/*******************************************************************\
+
+Function: ssa_local_unwindert::unwind_loops
+
+  Inputs: minimum unwinding depth for the function
+
+ Outputs: true if loop bodies have been added to the SSA
+
+ Purpose: unwind all loops up to their target unwinding depth
+          starting from previous unwindings
+
+\*******************************************************************/
+
+bool ssa_local_unwindert::unwind_loops(long k)
+{
+  bool changed=SSA.current_unwinding<k;
+  for(loop_mapt::iterator it=loops.begin(); it!=loops.end(); ++it)
+  {
+    if(it->second.target_unwinding>it->second.current_unwinding)
+      changed=true;
+    if(it->second.target_unwinding>k)
+      k=it->second.target_unwinding;
+  }
+  if(!changed)
+    return false;
 
   current_enabling_expr=
     symbol_exprt(
-      "unwind::"+id2string(fname)+"::enable"+i2string(k),
+      "unwind::"+id2string(fname)+"::enable"+
+      i2string(SSA.enabling_exprs.size()),
       bool_typet());
   SSA.enabling_exprs.push_back(current_enabling_expr);
 
   // TODO: just for exploratory integration, must go away
+  //  (this is the maximum unwinding depth of the loops)
   SSA.current_unwinding=k;
 
   // recursively unwind everything
@@ -295,14 +375,18 @@ void ssa_local_unwindert::unwind(unsigned k)
   {
     if(!it->second.is_root)
       continue;
-    unwind(it->second, k, false); // recursive
+    unwind(it->second, it->second.target_unwinding, false); // recursive
     assert(SSA.current_unwindings.empty());
   }
   // update current unwinding
   for(loop_mapt::iterator it=loops.begin(); it!=loops.end(); ++it)
   {
-    it->second.current_unwinding=k;
+    it->second.current_unwinding=it->second.target_unwinding;
   }
+  SSA.invalidate_node_index();
+
+  // a function without loops only gets a new enabling expression
+  return !loops.empty();
 }
 
 /*******************************************************************\
@@ -381,7 +465,10 @@ void ssa_local_unwindert::unwind(loopt &loop, unsigned k, bool is_new_parent)
 #ifdef DEBUG
       std::cout << i << ">" << loop.current_unwinding << std::endl;
 #endif
-      unwind(loops[l], k, i>loop.current_unwinding || is_new_parent);
+      unwind(
+        loops[l],
+        loops[l].target_unwinding,
+        i>loop.current_unwinding || is_new_parent);
     }
     SSA.increment_unwindings(0);
   }
@@ -702,13 +789,35 @@ Function: ssa_local_unwindert::loop_continuation_conditions
 
 void ssa_local_unwindert::loop_continuation_conditions(
   exprt::operandst& loop_cont) const
+{
+  std::vector<unsigned> loop_heads;
+  loop_continuation_conditions(loop_cont, loop_heads);
+}
+
+/*******************************************************************\
+
+Function: ssa_local_unwindert::loop_continuation_conditions
+
+  Inputs:
+
+ Outputs: loop continuation conditions for all loops in this function,
+          and the location number of the loop head for each of them
+
+ Purpose:
+
+\*******************************************************************/
+
+void ssa_local_unwindert::loop_continuation_conditions(
+  exprt::operandst& loop_cont,
+  std::vector<unsigned> &loop_heads) const
 {
   SSA.current_unwindings.clear();
   for(loop_mapt::const_iterator it=loops.begin(); it!=loops.end(); ++it)
   {
     if(!it->second.is_root)
       continue;
-    loop_continuation_conditions(it->second, loop_cont); // recursive
+    loop_continuation_conditions(
+      it->first, loop_cont, loop_heads); // recursive
     assert(SSA.current_unwindings.empty());
   }
 }
@@ -746,16 +855,20 @@ Function: ssa_local_unwindert::loop_continuation_conditions
 \*******************************************************************/
 
 void ssa_local_unwindert::loop_continuation_conditions(
-  const loopt& loop, exprt::operandst& loop_cont) const
+  unsigned loop_head_location_number,
+  exprt::operandst& loop_cont,
+  std::vector<unsigned> &loop_heads) const
 {
+  const loopt &loop=loops.at(loop_head_location_number);
   SSA.increment_unwindings(1);
   loop_cont.push_back(get_continuation_condition(loop)); // %0
+  loop_heads.push_back(loop_head_location_number);
   for(long i=0; i<=loop.current_unwinding; ++i)
   {
     // recurse into child loops
     for(const auto &l : loop.loop_nodes)
     {
-      loop_continuation_conditions(loops.at(l), loop_cont);
+      loop_continuation_conditions(l, loop_cont, loop_heads);
     }
     SSA.increment_unwindings(0);
   }
@@ -805,6 +918,17 @@ void ssa_local_unwindert::unwinder_rename(
   size_t pos1=id.find_last_of("%");
   std::string suffix;
   unsigned unwinding=pre ? SSA.current_unwinding : 0;
+  // the loop may have been unwound less often than others
+  if(pre)
+  {
+    unsigned loop_head=node.loophead!=SSA.nodes.end() ?
+      node.loophead->location->location_number :
+      node.location->location_number;
+    loop_mapt::const_iterator l_it=loops.find(loop_head);
+    if(l_it!=loops.end() &&
+       l_it->second.current_unwinding<(long)unwinding)
+      unwinding=l_it->second.current_unwinding;
+  }
   if(pos==pos1)
   {
     suffix="%"+i2string(unwinding);
@@ -865,7 +989,11 @@ void ssa_unwindert::unwind(const irep_idt fname, unsigned int k)
   assert(is_initialized);
   unwinder_mapt::iterator it=unwinder_map.find(fname);
   assert(it!=unwinder_map.end());
-  it->second.unwind(k);
+  if(it->second.unwind(k))
+  {
+    changed_functions.insert(fname);
+    ssa_db.share_expressions(std::set<irep_idt>{fname});
+  }
 }
 
 /*******************************************************************\
@@ -884,8 +1012,43 @@ void ssa_unwindert::unwind_all(unsigned int k)
 {
   assert(is_initialized);
 
+  std::set<irep_idt> unwound;
   for(auto &local_unwinder : unwinder_map)
-    local_unwinder.second.unwind(k);
+  {
+    if(local_unwinder.second.unwind(k))
+    {
+      changed_functions.insert(local_unwinder.first);
+      unwound.insert(local_unwinder.first);
+    }
+  }
+  ssa_db.share_expressions(unwound);
+}
+
+/*******************************************************************\
+
+Function: ssa_unwindert::unwind_further
+
+  Inputs: fname-name of the goto-function, location numbers of
+          loop heads in that function
+
+ Outputs:
+
+ Purpose: unwind the given loops in function 'fname' one more time
+
+\*******************************************************************/
+
+void ssa_unwindert::unwind_further(
+  const irep_idt fname,
+  const std::set<unsigned> &loop_head_location_numbers)
+{
+  assert(is_initialized);
+  unwinder_mapt::iterator it=unwinder_map.find(fname);
+  assert(it!=unwinder_map.end());
+  if(it->second.unwind_further(loop_head_location_numbers))
+  {
+    changed_functions.insert(fname);
+    ssa_db.share_expressions(std::set<irep_idt>{fname});
+  }
 }
 
 /*******************************************************************\
@@ -929,7 +1092,12 @@ Function: ssa_unwindert::init_localunwinders
 
 void ssa_unwindert::init_localunwinders()
 {
+  std::set<irep_idt> functions;
   for(auto &local_unwinder : unwinder_map)
+  {
     local_unwinder.second.init();
+    functions.insert(local_unwinder.first);
+  }
+  ssa_db.share_expressions(functions);
   is_initialized=true;
 }
@@ -32,19 +32,22 @@ public:
 
   void init();
 
-  void unwind(unsigned k);
+  // the following return true if loop bodies have been added to the SSA
 
-#if 0
-  // TODO: not yet sure how to do that
-  void unwind(locationt loop_head_loc, unsigned k)
-  {
-    unwind(loops[loop_head_loc], k);
-  }
-#endif
+  // unwind all loops up to at least k
+  bool unwind(unsigned k);
+  // unwind the loop with the given loop head up to at least k
+  bool unwind(unsigned loop_head_location_number, unsigned k);
+  // unwind the given loops one more time
+  bool unwind_further(const std::set<unsigned> &loop_head_location_numbers);
 
-  // TODO: this should be loop specific in future,
-  // maybe move to unwindable_local_ssa as it is not really unwinder related
+  // TODO: maybe move to unwindable_local_ssa
+  //  as it is not really unwinder related
   void loop_continuation_conditions(exprt::operandst& loop_cont) const;
+  // also returns the loop head location number for each condition
+  void loop_continuation_conditions(
+    exprt::operandst& loop_cont,
+    std::vector<unsigned> &loop_heads) const;
 
 #if 0
   // TODO: these two should be possible with unwindable_local_ssa facilities
@@ -67,7 +70,8 @@ public:
     loopt():
       is_dowhile(false),
       is_root(false),
-      current_unwinding(-1)
+      current_unwinding(-1),
+      target_unwinding(-1)
     {
     }
 
@@ -78,6 +82,7 @@ public:
     bool is_dowhile;
     bool is_root;
     long current_unwinding;
+    long target_unwinding; // for the next call to unwind()
     typedef std::map<exprt, exprt::operandst> exit_mapt;
     exit_mapt exit_map;
     std::map<symbol_exprt, symbol_exprt> pre_post_map;
@@ -110,12 +115,14 @@ protected:
   void build_pre_post_map();
   void build_exit_conditions();
 
+  bool unwind_loops(long k);
   void unwind(loopt &loop, unsigned k, bool is_new_parent);
 
   exprt get_continuation_condition(const loopt& loop) const;
   void loop_continuation_conditions(
-    const loopt& loop,
-    exprt::operandst &loop_cont) const;
+    unsigned loop_head_location_number,
+    exprt::operandst &loop_cont,
+    std::vector<unsigned> &loop_heads) const;
 
   void add_loop_body(loopt &loop);
   void add_assertions(loopt &loop, bool is_last);
@@ -147,6 +154,17 @@ public:
 
   void unwind(const irep_idt fname, unsigned k);
   void unwind_all(unsigned k);
+  void unwind_further(
+    const irep_idt fname,
+    const std::set<unsigned> &loop_head_location_numbers);
+
+  // functions whose SSA has grown since the last call
+  //  to clear_changed_functions()
+  const std::set<irep_idt> &get_changed_functions() const
+  {
+    return changed_functions;
+  }
+  void clear_changed_functions() { changed_functions.clear(); }
 
   inline ssa_local_unwindert &get(const irep_idt& fname)
   {
@@ -162,6 +180,7 @@ protected:
   ssa_dbt &ssa_db;
   bool is_initialized;
   unwinder_mapt unwinder_map;
+  std::set<irep_idt> changed_functions;
 };
 
 #endif
@@ -606,6 +606,15 @@ bool ssa_value_domaint::valuest::merge(
   }
 
   // value set
+  if(!is_loop_back && !src.value_set.has_iterators())
+  {
+    // no special treatment of iterators needed
+    if(value_set.insert(src.value_set))
+      result=true;
+    alignment=merge_alignment(alignment, src.alignment);
+    return result;
+  }
+
   unsigned long old_size=value_set.size();
   for(const ssa_objectt &v : src.value_set)
   {
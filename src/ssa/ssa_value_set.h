@@ -12,6 +12,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <analyses/ai.h>
 
 #include "ssa_object.h"
+#include "ssa_object_set.h"
 #include "ssa_heap_domain.h"
 
 class ssa_value_domaint:public ai_domain_baset
@@ -27,7 +28,7 @@ public:
   struct valuest
   {
   public:
-    typedef std::set<ssa_objectt> value_sett;
+    typedef ssa_object_sett value_sett;
     value_sett value_set;
     bool offset, null, unknown, integer_address;
     unsigned alignment;
@@ -289,9 +289,7 @@ void unwindable_local_SSAt::rename(exprt &expr, locationt current_loc)
     //      and def_loc to the symbol_expr itself
     irep_idt id=get_ssa_name(s, def_loc);
     unsigned def_level=get_def_level(def_loc, current_loc);
-    std::string unwind_suffix=
-      odometer_to_string(current_unwindings, def_level);
-    s.set_identifier(id2string(id)+unwind_suffix);
+    s.set_identifier(get_unwound_name(id, def_level));
 
 #if 0
     std::cout << "RENAME_SYMBOL: "
@@ -307,8 +305,12 @@ void unwindable_local_SSAt::rename(exprt &expr, locationt current_loc)
   }
   if(expr.id()==ID_nondet_symbol)
   {
-    std::string unwind_suffix=
-      odometer_to_string(current_unwindings, current_unwindings.size());
+    std::string unwind_suffix;
+    if(current_unwinding>=0)
+    {
+      update_prefixes();
+      unwind_suffix=prefix_suffixes.back();
+    }
     std::string identifier=id2string(expr.get(ID_identifier));
     std::size_t pos=identifier.find("%");
     if(pos!=std::string::npos)
@@ -336,6 +338,18 @@ Function: unwindable_local_SSAt::get_ssa_name
 irep_idt unwindable_local_SSAt::get_ssa_name(
   const symbol_exprt &symbol_expr, locationt &loc) const
 {
+  ssa_name_cachet::const_iterator c_it=
+    ssa_name_cache.find(symbol_expr.get_identifier());
+  if(c_it!=ssa_name_cache.end())
+  {
+    if(c_it->second.has_loc)
+      loc=c_it->second.loc;
+    return c_it->second.id;
+  }
+
+  ssa_namet &ssa_name=ssa_name_cache[symbol_expr.get_identifier()];
+  ssa_name.has_loc=false;
+
   std::string s=id2string(symbol_expr.get_identifier());
 #if 0
   std::cout << "id: " << s << std::endl;
@@ -343,7 +357,10 @@ irep_idt unwindable_local_SSAt::get_ssa_name(
   std::size_t pos2=s.find("%");
   std::size_t pos1=s.find_last_of("#");
   if(pos1==std::string::npos)
-    return irep_idt(s);
+  {
+    ssa_name.id=irep_idt(s);
+    return ssa_name.id;
+  }
   if(pos2==std::string::npos)
     pos2=s.size();
   if(s.substr(pos1+1, 2)=="lb")
@@ -355,14 +372,95 @@ irep_idt unwindable_local_SSAt::get_ssa_name(
   else if(s.substr(pos1+1, 3)=="phi")
     pos1+=3;
   else if((pos2==pos1+13) && (s.substr(pos1+1, 12)=="return_value"))
-    return irep_idt(s);
+  {
+    ssa_name.id=irep_idt(s);
+    return ssa_name.id;
+  }
 #if 0
   std::cout << s << ", " << s.substr(pos1+1, pos2-pos1-1)
             << ", " << s.substr(0, pos2) << std::endl;
 #endif
   loc=get_location(
     safe_string2unsigned(s.substr(pos1+1, pos2-pos1-1)));
-  return irep_idt(s.substr(0, pos2));
+  ssa_name.has_loc=true;
+  ssa_name.loc=loc;
+  ssa_name.id=irep_idt(s.substr(0, pos2));
+  return ssa_name.id;
+}
+
+/*******************************************************************\
+
+Function: unwindable_local_SSAt::update_prefixes
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: numbers the prefixes of current_unwindings and computes
+          their suffixes if current_unwindings has changed
+
+\*******************************************************************/
+
+void unwindable_local_SSAt::update_prefixes()
+{
+  if(!prefix_numbers.empty() && cached_unwindings==current_unwindings)
+    return;
+
+  cached_unwindings=current_unwindings;
+  prefix_numbers.resize(current_unwindings.size()+1);
+  prefix_suffixes.resize(current_unwindings.size()+1);
+
+  odometert prefix;
+  for(std::size_t level=0; level<=current_unwindings.size(); ++level)
+  {
+    if(level>0)
+    {
+      prefix.push_back(current_unwindings[level-1]);
+      prefix_suffixes[level]=prefix_suffixes[level-1]+
+        "%"+std::to_string(current_unwindings[level-1]);
+    }
+    else
+      prefix_suffixes[level]="";
+    std::pair<std::map<odometert, unsigned>::iterator, bool> entry=
+      odometer_numbers.insert(
+        std::make_pair(prefix, odometer_numbers.size()));
+    prefix_numbers[level]=entry.first->second;
+  }
+}
+
+/*******************************************************************\
+
+Function: unwindable_local_SSAt::get_unwound_name
+
+  Inputs: ssa name, definition level
+
+ Outputs: the ssa name with the suffix of the current unwinding
+          up to the given level
+
+ Purpose:
+
+\*******************************************************************/
+
+irep_idt unwindable_local_SSAt::get_unwound_name(
+  const irep_idt &id,
+  unsigned level)
+{
+  // the suffix is empty before the first unwinding
+  if(current_unwinding<0)
+    return id;
+
+  update_prefixes();
+  if(level>current_unwindings.size())
+    level=current_unwindings.size();
+
+  std::pair<rename_cachet::iterator, bool> entry=
+    rename_cache.insert(
+      std::make_pair(
+        std::make_pair(id.get_no(), prefix_numbers[level]),
+        irep_idt()));
+  if(entry.second)
+    entry.first->second=irep_idt(id2string(id)+prefix_suffixes[level]);
+  return entry.first->second;
 }
 
 /*******************************************************************\
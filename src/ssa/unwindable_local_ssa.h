@@ -9,6 +9,8 @@ Author: Peter Schrammel, Saurabh Joshi
 #ifndef CPROVER_2LS_SSA_UNWINDABLE_LOCAL_SSA_H
 #define CPROVER_2LS_SSA_UNWINDABLE_LOCAL_SSA_H
 
+#include <unordered_map>
+
 #include <util/message.h>
 
 #include "local_ssa.h"
@@ -88,6 +90,43 @@ protected:
 
   unsigned get_def_level(locationt def_loc, locationt current_loc) const;
   void compute_loop_hierarchy();
+
+  // renaming is memoized as every unwinding renames
+  //  all symbols in the copies of the loop bodies
+
+  // identifier -> ssa name and location
+  struct ssa_namet
+  {
+    irep_idt id;
+    bool has_loc;
+    locationt loc;
+  };
+  typedef std::unordered_map<irep_idt, ssa_namet, irep_id_hash>
+    ssa_name_cachet;
+  mutable ssa_name_cachet ssa_name_cache;
+
+  // the prefixes of the odometer are numbered;
+  //  the numbers and suffixes of the prefixes of current_unwindings
+  //  are updated when current_unwindings changes
+  std::map<odometert, unsigned> odometer_numbers;
+  odometert cached_unwindings;
+  std::vector<unsigned> prefix_numbers;
+  std::vector<std::string> prefix_suffixes;
+  void update_prefixes();
+
+  // (ssa name, number of the odometer prefix) -> renamed identifier
+  struct rename_key_hasht
+  {
+    std::size_t operator()(const std::pair<unsigned, unsigned> &key) const
+    {
+      return (std::size_t(key.first)<<20)^key.second;
+    }
+  };
+  typedef std::unordered_map<
+    std::pair<unsigned, unsigned>, irep_idt, rename_key_hasht>
+    rename_cachet;
+  rename_cachet rename_cache;
+  irep_idt get_unwound_name(const irep_idt &id, unsigned level);
 };
 
 #endif